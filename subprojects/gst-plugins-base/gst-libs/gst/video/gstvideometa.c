@@ -21,6 +21,7 @@
 #endif
 
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 #include <gst/base/base.h>
@@ -457,6 +458,14 @@ gst_buffer_add_video_meta_full (GstBuffer * buffer,
   return meta;
 }
 
+/* Whether the planes of @meta are mapped from the memory of its buffer, at
+ * the meta offsets and strides, by the default map and unmap functions */
+gboolean
+__gst_video_meta_has_default_map (const GstVideoMeta * meta)
+{
+  return meta->map == default_map && meta->unmap == default_unmap;
+}
+
 /**
  * gst_video_meta_map:
  * @meta: a #GstVideoMeta
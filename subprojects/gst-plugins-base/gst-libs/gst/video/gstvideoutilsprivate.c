@@ -259,3 +259,157 @@ __gst_video_encoded_video_convert (gint64 bytes, gint64 time,
 exit:
   return res;
 }
+
+/* Runs a function on multiple threads of a task pool, used to process
+ * stripes of a frame in parallel */
+typedef struct _GstParallelizedWorkItem GstParallelizedWorkItem;
+
+struct _GstParallelizedWorkItem
+{
+  GstParallelizedTaskRunner *self;
+  GstParallelizedTaskFunc func;
+  gpointer user_data;
+};
+
+static void
+gst_parallelized_task_thread_func (gpointer data)
+{
+  GstParallelizedTaskRunner *runner = data;
+  GstParallelizedWorkItem *work_item;
+
+  g_mutex_lock (&runner->lock);
+  work_item = gst_vec_deque_pop_head (runner->work_items);
+  g_mutex_unlock (&runner->lock);
+
+  g_assert (work_item != NULL);
+  g_assert (work_item->func != NULL);
+
+
+  work_item->func (work_item->user_data);
+  if (runner->async_tasks)
+    g_free (work_item);
+}
+
+static void
+gst_parallelized_task_runner_join (GstParallelizedTaskRunner * self)
+{
+  gboolean joined = FALSE;
+
+  while (!joined) {
+    g_mutex_lock (&self->lock);
+    if (!(joined = gst_vec_deque_is_empty (self->tasks))) {
+      gpointer task = gst_vec_deque_pop_head (self->tasks);
+      g_mutex_unlock (&self->lock);
+      gst_task_pool_join (self->pool, task);
+    } else {
+      g_mutex_unlock (&self->lock);
+    }
+  }
+}
+
+void
+gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
+{
+  gst_parallelized_task_runner_join (self);
+
+  gst_vec_deque_free (self->work_items);
+  gst_vec_deque_free (self->tasks);
+  if (self->own_pool)
+    gst_task_pool_cleanup (self->pool);
+  gst_object_unref (self->pool);
+  g_mutex_clear (&self->lock);
+  g_free (self);
+}
+
+GstParallelizedTaskRunner *
+gst_parallelized_task_runner_new (guint n_threads, GstTaskPool * pool,
+    gboolean async_tasks)
+{
+  GstParallelizedTaskRunner *self;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  self = g_new0 (GstParallelizedTaskRunner, 1);
+
+  if (pool) {
+    self->pool = g_object_ref (pool);
+    self->own_pool = FALSE;
+
+    /* No reason to split up the work between more threads than the
+     * pool can spawn */
+    if (GST_IS_SHARED_TASK_POOL (pool))
+      n_threads =
+          MIN (n_threads,
+          gst_shared_task_pool_get_max_threads (GST_SHARED_TASK_POOL (pool)));
+  } else {
+    self->pool = gst_shared_task_pool_new ();
+    self->own_pool = TRUE;
+    gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL (self->pool),
+        n_threads);
+    gst_task_pool_prepare (self->pool, NULL);
+  }
+
+  self->tasks = gst_vec_deque_new (n_threads);
+  self->work_items = gst_vec_deque_new (n_threads);
+
+  self->n_threads = n_threads;
+
+  g_mutex_init (&self->lock);
+
+  /* Set when scheduling a job */
+  self->async_tasks = async_tasks;
+
+  return self;
+}
+
+void
+gst_parallelized_task_runner_finish (GstParallelizedTaskRunner * self)
+{
+  gst_parallelized_task_runner_join (self);
+}
+
+void
+gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  guint n_threads = self->n_threads;
+
+  if (n_threads > 1 || self->async_tasks) {
+    guint i = 0;
+    g_mutex_lock (&self->lock);
+    if (!self->async_tasks) {
+      /* if not async, perform one of the functions in the current thread */
+      i = 1;
+    }
+    for (; i < n_threads; i++) {
+      gpointer task;
+      GstParallelizedWorkItem *work_item;
+
+      if (!self->async_tasks)
+        work_item = g_newa (GstParallelizedWorkItem, 1);
+      else
+        work_item = g_new0 (GstParallelizedWorkItem, 1);
+
+      work_item->self = self;
+      work_item->func = func;
+      work_item->user_data = task_data[i];
+      gst_vec_deque_push_tail (self->work_items, work_item);
+
+      task =
+          gst_task_pool_push (self->pool, gst_parallelized_task_thread_func,
+          self, NULL);
+
+      /* The return value of push() is unfortunately nullable, and we can't deal with that */
+      g_assert (task != NULL);
+      gst_vec_deque_push_tail (self->tasks, task);
+    }
+    g_mutex_unlock (&self->lock);
+  }
+
+  if (!self->async_tasks) {
+    func (task_data[0]);
+
+    gst_parallelized_task_runner_finish (self);
+  }
+}
@@ -46,6 +46,49 @@ gboolean __gst_video_rawvideo_convert (GstVideoCodecState * state, GstFormat src
                                        gint64 src_value, GstFormat * dest_format,
                                        gint64 * dest_value);
 
+/* Parallelized task runner, shared by the converter and the blending code */
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+
+struct _GstParallelizedTaskRunner
+{
+  GstTaskPool *pool;
+  gboolean own_pool;
+  guint n_threads;
+
+  GstVecDeque *tasks;
+  GstVecDeque *work_items;
+
+  GMutex lock;
+
+  gboolean async_tasks;
+};
+
+G_GNUC_INTERNAL
+GstParallelizedTaskRunner * gst_parallelized_task_runner_new (guint n_threads,
+                                                              GstTaskPool * pool,
+                                                              gboolean async_tasks);
+
+G_GNUC_INTERNAL
+void     gst_parallelized_task_runner_free   (GstParallelizedTaskRunner * self);
+
+G_GNUC_INTERNAL
+void     gst_parallelized_task_runner_run    (GstParallelizedTaskRunner * self,
+                                              GstParallelizedTaskFunc func,
+                                              gpointer * task_data);
+
+G_GNUC_INTERNAL
+void     gst_parallelized_task_runner_finish (GstParallelizedTaskRunner * self);
+
+G_GNUC_INTERNAL
+gboolean __gst_video_blend_with_runner (GstVideoFrame * dest, GstVideoFrame * src,
+                                        gint x, gint y, gfloat global_alpha,
+                                        GstParallelizedTaskRunner * runner);
+
+G_GNUC_INTERNAL
+gboolean __gst_video_meta_has_default_map (const GstVideoMeta * meta);
+
 G_END_DECLS
 
 #endif
@@ -29,6 +29,7 @@
 
 #include "video-blend.h"
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 
@@ -283,6 +284,215 @@ G_STMT_START { \
 } G_STMT_END
 
 
+typedef struct
+{
+  GstVideoFrame *dest;
+  GstVideoFrame *src;
+  const GstVideoFormatInfo *dinfo;
+  const GstVideoFormatInfo *sinfo;
+  void (*matrix) (guint8 * tmpline, guint width);
+  gboolean src_premultiplied_alpha;
+  gboolean dest_premultiplied_alpha;
+  gint global_alpha_val;
+  gint bpp;
+  gint x;
+  gint src_xoff;
+  gint src_width;
+  gint dest_width;
+
+  /* destination lines [y_start, y_end) are blended with the source lines
+   * starting at src_yoff */
+  gint y_start;
+  gint y_end;
+  gint src_yoff;
+
+  guint8 *tmpsrcline;
+  guint8 *tmpdestline;
+} BlendTask;
+
+/* unpacks each destination line, blends the source into it and packs it
+ * again */
+static void
+video_blend_lines (BlendTask * task)
+{
+  GstVideoFrame *dest = task->dest;
+  GstVideoFrame *src = task->src;
+  const GstVideoFormatInfo *dinfo = task->dinfo;
+  const GstVideoFormatInfo *sinfo = task->sinfo;
+  gboolean src_premultiplied_alpha = task->src_premultiplied_alpha;
+  gboolean dest_premultiplied_alpha = task->dest_premultiplied_alpha;
+  gint global_alpha_val = task->global_alpha_val;
+  gint bpp = task->bpp;
+  gint x = task->x;
+  gint src_width = task->src_width;
+  gint dest_width = task->dest_width;
+  gint src_yoff = task->src_yoff;
+  guint8 *tmpsrcline = task->tmpsrcline;
+  guint8 *tmpdestline = task->tmpdestline;
+  gint i, j;
+
+  for (i = task->y_start; i < task->y_end; i++, src_yoff++) {
+
+    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
+        0, i, dest_width);
+    sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
+        task->src_xoff, src_yoff, src_width);
+
+    /* FIXME: use the x parameter of the unpack func once implemented */
+    tmpdestline += bpp * x;
+
+    task->matrix (tmpsrcline, src_width);
+
+#define BLENDLOOP(op, dest_type, max, shift, alpha_val)                                       \
+  G_STMT_START {                                                                              \
+    for (j = 0; j < src_width * 4; j += 4) {                                                  \
+      guint asrc, adst;                                                                       \
+      guint final_alpha;                                                                      \
+      dest_type * dest = (dest_type *) tmpdestline;                                           \
+                                                                                              \
+      asrc = ((guint) tmpsrcline[j]) * alpha_val / max;                                       \
+      asrc = asrc << shift;                                                                   \
+      if (asrc == 0)                                                                          \
+        continue;                                                                             \
+                                                                                              \
+      adst = dest[j];                                                                         \
+      final_alpha = asrc + adst * (max - asrc) / max;                                         \
+      dest[j] = final_alpha;                                                                  \
+      if (final_alpha == 0)                                                                   \
+        final_alpha = 1;                                                                      \
+                                                                                              \
+      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 1] << shift, adst, dest[j + 1], final_alpha); \
+      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 2] << shift, adst, dest[j + 2], final_alpha); \
+      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 3] << shift, adst, dest[j + 3], final_alpha); \
+    }                                                                                         \
+  } G_STMT_END
+
+    if (bpp == 4) {
+      if (G_LIKELY (global_alpha_val == 255)) {
+        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER11, guint8, 255, 0, 255);
+        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER01, guint8, 255, 0, 255);
+        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+          BLENDLOOP (OVER10_8BIT, guint8, 255, 0, 255);
+        } else {
+          BLENDLOOP (OVER00_8BIT, guint8, 255, 0, 255);
+        }
+      } else {
+        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER11, guint8, 255, 0, global_alpha_val);
+        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER01, guint8, 255, 0, global_alpha_val);
+        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+          BLENDLOOP (OVER10_8BIT, guint8, 255, 0, global_alpha_val);
+        } else {
+          BLENDLOOP (OVER00_8BIT, guint8, 255, 0, global_alpha_val);
+        }
+      }
+    } else {
+      g_assert (bpp == 8);
+
+      if (G_LIKELY (global_alpha_val == 65535)) {
+        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER11, guint16, 65535, 8, 65535);
+        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER01, guint16, 65535, 8, 65535);
+        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+          BLENDLOOP (OVER10_16BIT, guint16, 65535, 8, 65535);
+        } else {
+          BLENDLOOP (OVER00_16BIT, guint16, 65535, 8, 65535);
+        }
+      } else {
+        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER11, guint16, 65535, 8, global_alpha_val);
+        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+          BLENDLOOP (OVER01, guint16, 65535, 8, global_alpha_val);
+        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+          BLENDLOOP (OVER10_16BIT, guint16, 65535, 8, global_alpha_val);
+        } else {
+          BLENDLOOP (OVER00_16BIT, guint16, 65535, 8, global_alpha_val);
+        }
+      }
+    }
+
+#undef BLENDLOOP
+
+    /* undo previous pointer adjustments to pass right pointer to g_free */
+    tmpdestline -= bpp * x;
+
+    /* FIXME
+     * #if G_BYTE_ORDER == LITTLE_ENDIAN
+     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
+     * #else
+     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
+     * #endif
+     */
+
+    dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
+        dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
+  }
+}
+
+/* The destination has no alpha, so the blended alpha is always 255 and the
+ * OVER operations above reduce to this */
+#define BLEND_OPAQUE_U8(ca, cb, alphaA, alphaC) \
+  MIN (((ca) * (alphaC) + (cb) * (255 - (alphaA))) / 255, 255)
+
+/* Blends directly into the planes of 8 bits 4:2:0 destinations, only
+ * touching the pixels covered by the source. Like the pack functions, the
+ * chroma of each 2x2 block is taken from its top-left pixel. */
+static void
+video_blend_lines_420 (BlendTask * task)
+{
+  GstVideoFrame *dest = task->dest;
+  GstVideoFrame *src = task->src;
+  const GstVideoFormatInfo *sinfo = task->sinfo;
+  gint global_alpha_val = task->global_alpha_val;
+  gint x = task->x;
+  gint src_width = task->src_width;
+  gint src_yoff = task->src_yoff;
+  guint8 *tmpsrcline = task->tmpsrcline;
+  gint uv_pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (dest, GST_VIDEO_COMP_U);
+  gint i, j;
+
+  for (i = task->y_start; i < task->y_end; i++, src_yoff++) {
+    guint8 *dy, *du, *dv;
+    gboolean chroma_line = !(i & 1);
+
+    sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
+        task->src_xoff, src_yoff, src_width);
+    task->matrix (tmpsrcline, src_width);
+
+    dy = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_Y) +
+        i * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_Y) + x;
+    du = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_U) +
+        (i >> 1) * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_U);
+    dv = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_V) +
+        (i >> 1) * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_V);
+
+    for (j = 0; j < src_width; j++) {
+      const guint8 *s = tmpsrcline + j * 4;
+      guint asrc, acolor;
+
+      asrc = s[0] * global_alpha_val / 255;
+      if (asrc == 0)
+        continue;
+      acolor = task->src_premultiplied_alpha ? global_alpha_val : asrc;
+
+      dy[j] = BLEND_OPAQUE_U8 (s[1], dy[j], asrc, acolor);
+
+      if (chroma_line && !((x + j) & 1)) {
+        gint k = ((x + j) >> 1) * uv_pstride;
+
+        du[k] = BLEND_OPAQUE_U8 (s[2], du[k], asrc, acolor);
+        dv[k] = BLEND_OPAQUE_U8 (s[3], dv[k], asrc, acolor);
+      }
+    }
+  }
+}
+
+#undef BLEND_OPAQUE_U8
+
 /**
  * gst_video_blend:
  * @dest: The #GstVideoFrame where to blend @src in
@@ -298,13 +508,25 @@ gboolean
 gst_video_blend (GstVideoFrame * dest,
     GstVideoFrame * src, gint x, gint y, gfloat global_alpha)
 {
-  gint i, j, global_alpha_val, src_width, src_height, dest_width, dest_height;
+  return __gst_video_blend_with_runner (dest, src, x, y, global_alpha, NULL);
+}
+
+/* Blends @src into @dest like gst_video_blend(). When @runner is not %NULL
+ * the lines are split into stripes that are blended in parallel. */
+gboolean
+__gst_video_blend_with_runner (GstVideoFrame * dest,
+    GstVideoFrame * src, gint x, gint y, gfloat global_alpha,
+    GstParallelizedTaskRunner * runner)
+{
+  gint i, global_alpha_val, src_width, src_height, dest_width, dest_height;
   gint src_xoff = 0, src_yoff = 0;
-  guint8 *tmpdestline = NULL, *tmpsrcline = NULL;
   gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
-  gint bpp;
+  gint bpp, n_tasks, lines_per_task, align, first_line;
   void (*matrix) (guint8 * tmpline, guint width);
+  void (*blend_lines) (BlendTask * task);
   const GstVideoFormatInfo *sinfo, *dinfo, *dunpackinfo, *sunpackinfo;
+  BlendTask *tasks;
+  BlendTask **tasks_p;
 
   g_assert (dest != NULL);
   g_assert (src != NULL);
@@ -392,114 +614,67 @@ gst_video_blend (GstVideoFrame * dest,
   if (y + src_height > dest_height)
     src_height = dest_height - y;
 
-  tmpsrcline = g_malloc (sizeof (guint8) * (src_width + 8) * 4);
-  tmpdestline = g_malloc (sizeof (guint8) * (dest_width + 8) * bpp);
-
-  /* Mainloop doing the needed conversions, and blending */
-  for (i = y; i < y + src_height; i++, src_yoff++) {
-
-    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
-        0, i, dest_width);
-    sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
-        src_xoff, src_yoff, src_width);
-
-    /* FIXME: use the x parameter of the unpack func once implemented */
-    tmpdestline += bpp * x;
-
-    matrix (tmpsrcline, src_width);
-
-#define BLENDLOOP(op, dest_type, max, shift, alpha_val)                                       \
-  G_STMT_START {                                                                              \
-    for (j = 0; j < src_width * 4; j += 4) {                                                  \
-      guint asrc, adst;                                                                       \
-      guint final_alpha;                                                                      \
-      dest_type * dest = (dest_type *) tmpdestline;                                           \
-                                                                                              \
-      asrc = ((guint) tmpsrcline[j]) * alpha_val / max;                                       \
-      asrc = asrc << shift;                                                                   \
-      if (asrc == 0)                                                                          \
-        continue;                                                                             \
-                                                                                              \
-      adst = dest[j];                                                                         \
-      final_alpha = asrc + adst * (max - asrc) / max;                                         \
-      dest[j] = final_alpha;                                                                  \
-      if (final_alpha == 0)                                                                   \
-        final_alpha = 1;                                                                      \
-                                                                                              \
-      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 1] << shift, adst, dest[j + 1], final_alpha); \
-      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 2] << shift, adst, dest[j + 2], final_alpha); \
-      BLENDC (op, max, alpha_val, asrc, tmpsrcline[j + 3] << shift, adst, dest[j + 3], final_alpha); \
-    }                                                                                         \
-  } G_STMT_END
-
-    if (bpp == 4) {
-      if (G_LIKELY (global_alpha_val == 255)) {
-        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER11, guint8, 255, 0, 255);
-        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER01, guint8, 255, 0, 255);
-        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-          BLENDLOOP (OVER10_8BIT, guint8, 255, 0, 255);
-        } else {
-          BLENDLOOP (OVER00_8BIT, guint8, 255, 0, 255);
-        }
-      } else {
-        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER11, guint8, 255, 0, global_alpha_val);
-        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER01, guint8, 255, 0, global_alpha_val);
-        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-          BLENDLOOP (OVER10_8BIT, guint8, 255, 0, global_alpha_val);
-        } else {
-          BLENDLOOP (OVER00_8BIT, guint8, 255, 0, global_alpha_val);
-        }
-      }
-    } else {
-      g_assert (bpp == 8);
-
-      if (G_LIKELY (global_alpha_val == 65535)) {
-        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER11, guint16, 65535, 8, 65535);
-        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER01, guint16, 65535, 8, 65535);
-        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-          BLENDLOOP (OVER10_16BIT, guint16, 65535, 8, 65535);
-        } else {
-          BLENDLOOP (OVER00_16BIT, guint16, 65535, 8, 65535);
-        }
-      } else {
-        if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER11, guint16, 65535, 8, global_alpha_val);
-        } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-          BLENDLOOP (OVER01, guint16, 65535, 8, global_alpha_val);
-        } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-          BLENDLOOP (OVER10_16BIT, guint16, 65535, 8, global_alpha_val);
-        } else {
-          BLENDLOOP (OVER00_16BIT, guint16, 65535, 8, global_alpha_val);
-        }
-      }
-    }
-
-#undef BLENDLOOP
+  switch (GST_VIDEO_FRAME_FORMAT (dest)) {
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YV12:
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+      blend_lines = video_blend_lines_420;
+      break;
+    default:
+      blend_lines = video_blend_lines;
+      break;
+  }
 
-    /* undo previous pointer adjustments to pass right pointer to g_free */
-    tmpdestline -= bpp * x;
+  /* stripes must not share chroma lines or packed groups of lines */
+  align = MAX (dinfo->pack_lines, 1 << GST_VIDEO_FORMAT_INFO_H_SUB (dinfo, 1));
+
+  first_line = GST_ROUND_DOWN_N (y, align);
+  n_tasks = runner ? runner->n_threads : 1;
+  lines_per_task = (y + src_height - first_line + n_tasks - 1) / n_tasks;
+  lines_per_task = GST_ROUND_UP_N (lines_per_task, align);
+
+  tasks = g_newa (BlendTask, n_tasks);
+  tasks_p = g_newa (BlendTask *, n_tasks);
+
+  for (i = 0; i < n_tasks; i++) {
+    gint start = MAX (first_line + i * lines_per_task, y);
+    gint end = first_line + (i + 1) * lines_per_task;
+
+    tasks[i].dest = dest;
+    tasks[i].src = src;
+    tasks[i].dinfo = dinfo;
+    tasks[i].sinfo = sinfo;
+    tasks[i].matrix = matrix;
+    tasks[i].src_premultiplied_alpha = src_premultiplied_alpha;
+    tasks[i].dest_premultiplied_alpha = dest_premultiplied_alpha;
+    tasks[i].global_alpha_val = global_alpha_val;
+    tasks[i].bpp = bpp;
+    tasks[i].x = x;
+    tasks[i].src_xoff = src_xoff;
+    tasks[i].src_width = src_width;
+    tasks[i].dest_width = dest_width;
+    tasks[i].y_start = MIN (start, y + src_height);
+    tasks[i].y_end = MIN (end, y + src_height);
+    tasks[i].src_yoff = src_yoff + tasks[i].y_start - y;
+    tasks[i].tmpsrcline = g_malloc (sizeof (guint8) * (src_width + 8) * 4);
+    tasks[i].tmpdestline = blend_lines == video_blend_lines ?
+        g_malloc (sizeof (guint8) * (dest_width + 8) * bpp) : NULL;
+
+    tasks_p[i] = &tasks[i];
+  }
 
-    /* FIXME
-     * #if G_BYTE_ORDER == LITTLE_ENDIAN
-     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
-     * #else
-     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
-     * #endif
-     */
+  if (runner)
+    gst_parallelized_task_runner_run (runner,
+        (GstParallelizedTaskFunc) blend_lines, (gpointer) tasks_p);
+  else
+    blend_lines (tasks_p[0]);
 
-    dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
-        dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
+  for (i = 0; i < n_tasks; i++) {
+    g_free (tasks[i].tmpdestline);
+    g_free (tasks[i].tmpsrcline);
   }
 
-  g_free (tmpdestline);
-  g_free (tmpsrcline);
-
   return TRUE;
 
 failed:
@@ -37,6 +37,7 @@
 #include <gst/base/base.h>
 
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 /**
  * SECTION:videoconverter
@@ -116,175 +117,6 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
-typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
-
-typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedWorkItem GstParallelizedWorkItem;
-
-struct _GstParallelizedWorkItem
-{
-  GstParallelizedTaskRunner *self;
-  GstParallelizedTaskFunc func;
-  gpointer user_data;
-};
-
-struct _GstParallelizedTaskRunner
-{
-  GstTaskPool *pool;
-  gboolean own_pool;
-  guint n_threads;
-
-  GstVecDeque *tasks;
-  GstVecDeque *work_items;
-
-  GMutex lock;
-
-  gboolean async_tasks;
-};
-
-static void
-gst_parallelized_task_thread_func (gpointer data)
-{
-  GstParallelizedTaskRunner *runner = data;
-  GstParallelizedWorkItem *work_item;
-
-  g_mutex_lock (&runner->lock);
-  work_item = gst_vec_deque_pop_head (runner->work_items);
-  g_mutex_unlock (&runner->lock);
-
-  g_assert (work_item != NULL);
-  g_assert (work_item->func != NULL);
-
-
-  work_item->func (work_item->user_data);
-  if (runner->async_tasks)
-    g_free (work_item);
-}
-
-static void
-gst_parallelized_task_runner_join (GstParallelizedTaskRunner * self)
-{
-  gboolean joined = FALSE;
-
-  while (!joined) {
-    g_mutex_lock (&self->lock);
-    if (!(joined = gst_vec_deque_is_empty (self->tasks))) {
-      gpointer task = gst_vec_deque_pop_head (self->tasks);
-      g_mutex_unlock (&self->lock);
-      gst_task_pool_join (self->pool, task);
-    } else {
-      g_mutex_unlock (&self->lock);
-    }
-  }
-}
-
-static void
-gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
-{
-  gst_parallelized_task_runner_join (self);
-
-  gst_vec_deque_free (self->work_items);
-  gst_vec_deque_free (self->tasks);
-  if (self->own_pool)
-    gst_task_pool_cleanup (self->pool);
-  gst_object_unref (self->pool);
-  g_mutex_clear (&self->lock);
-  g_free (self);
-}
-
-static GstParallelizedTaskRunner *
-gst_parallelized_task_runner_new (guint n_threads, GstTaskPool * pool,
-    gboolean async_tasks)
-{
-  GstParallelizedTaskRunner *self;
-
-  if (n_threads == 0)
-    n_threads = g_get_num_processors ();
-
-  self = g_new0 (GstParallelizedTaskRunner, 1);
-
-  if (pool) {
-    self->pool = g_object_ref (pool);
-    self->own_pool = FALSE;
-
-    /* No reason to split up the work between more threads than the
-     * pool can spawn */
-    if (GST_IS_SHARED_TASK_POOL (pool))
-      n_threads =
-          MIN (n_threads,
-          gst_shared_task_pool_get_max_threads (GST_SHARED_TASK_POOL (pool)));
-  } else {
-    self->pool = gst_shared_task_pool_new ();
-    self->own_pool = TRUE;
-    gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL (self->pool),
-        n_threads);
-    gst_task_pool_prepare (self->pool, NULL);
-  }
-
-  self->tasks = gst_vec_deque_new (n_threads);
-  self->work_items = gst_vec_deque_new (n_threads);
-
-  self->n_threads = n_threads;
-
-  g_mutex_init (&self->lock);
-
-  /* Set when scheduling a job */
-  self->async_tasks = async_tasks;
-
-  return self;
-}
-
-static void
-gst_parallelized_task_runner_finish (GstParallelizedTaskRunner * self)
-{
-  gst_parallelized_task_runner_join (self);
-}
-
-static void
-gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
-    GstParallelizedTaskFunc func, gpointer * task_data)
-{
-  guint n_threads = self->n_threads;
-
-  if (n_threads > 1 || self->async_tasks) {
-    guint i = 0;
-    g_mutex_lock (&self->lock);
-    if (!self->async_tasks) {
-      /* if not async, perform one of the functions in the current thread */
-      i = 1;
-    }
-    for (; i < n_threads; i++) {
-      gpointer task;
-      GstParallelizedWorkItem *work_item;
-
-      if (!self->async_tasks)
-        work_item = g_newa (GstParallelizedWorkItem, 1);
-      else
-        work_item = g_new0 (GstParallelizedWorkItem, 1);
-
-      work_item->self = self;
-      work_item->func = func;
-      work_item->user_data = task_data[i];
-      gst_vec_deque_push_tail (self->work_items, work_item);
-
-      task =
-          gst_task_pool_push (self->pool, gst_parallelized_task_thread_func,
-          self, NULL);
-
-      /* The return value of push() is unfortunately nullable, and we can't deal with that */
-      g_assert (task != NULL);
-      gst_vec_deque_push_tail (self->tasks, task);
-    }
-    g_mutex_unlock (&self->lock);
-  }
-
-  if (!self->async_tasks) {
-    func (task_data[0]);
-
-    gst_parallelized_task_runner_finish (self);
-  }
-}
-
 typedef struct _GstLineCache GstLineCache;
 
 #define SCALE    (8)
@@ -317,6 +149,15 @@ struct _GammaData
   void (*gamma_func) (GammaData * data, gpointer dest, gpointer src);
 };
 
+typedef struct _LutData LutData;
+
+struct _LutData
+{
+  guint16 *table;
+  gint size;
+  guint scale;
+};
+
 typedef enum
 {
   ALPHA_MODE_NONE = 0,
@@ -327,7 +168,9 @@ typedef enum
 
 typedef struct
 {
+  guint8 *mem;
   guint8 *data;
+  guint size;
   guint stride;
   guint n_lines;
   guint idx;
@@ -335,6 +178,9 @@ typedef struct
   GDestroyNotify notify;
 } ConverterAlloc;
 
+/* alignment of the temporary lines, one cache line */
+#define CONVERTER_ALLOC_ALIGN 64
+
 typedef void (*FastConvertFunc) (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest, gint plane);
 
@@ -418,6 +264,8 @@ struct _GstVideoConverter
   MatrixData convert_matrix;
   gint in_bits;
   gint out_bits;
+  /* 3D LUT replacing to R'G'B', gamma and to Y'CbCr */
+  LutData lut;
 
   /* alpha correction */
   GstLineCache **alpha_lines;
@@ -646,6 +494,8 @@ static gboolean do_downsample_lines (GstLineCache * cache, gint idx,
     gint out_line, gint in_line, gpointer user_data);
 static gboolean do_convert_to_RGB_lines (GstLineCache * cache, gint idx,
     gint out_line, gint in_line, gpointer user_data);
+static gboolean do_convert_lut_lines (GstLineCache * cache, gint idx,
+    gint out_line, gint in_line, gpointer user_data);
 static gboolean do_convert_lines (GstLineCache * cache, gint idx, gint out_line,
     gint in_line, gpointer user_data);
 static gboolean do_alpha_lines (GstLineCache * cache, gint idx, gint out_line,
@@ -662,14 +512,25 @@ static gboolean do_dither_lines (GstLineCache * cache, gint idx, gint out_line,
     gint in_line, gpointer user_data);
 
 static ConverterAlloc *
-converter_alloc_new (guint stride, guint n_lines, gpointer user_data,
+converter_alloc_new (guint size, guint n_lines, gpointer user_data,
     GDestroyNotify notify)
 {
   ConverterAlloc *alloc;
+  guint stride;
+
+  /* start every line on a cache line. The lines of all the steps are
+   * processed together, avoid strides that are a multiple of the page size
+   * so that they don't all map to the same cache sets */
+  stride = GST_ROUND_UP_N (size, CONVERTER_ALLOC_ALIGN);
+  if (stride % 4096 == 0)
+    stride += CONVERTER_ALLOC_ALIGN;
 
-  GST_LOG ("stride %d, n_lines %d", stride, n_lines);
+  GST_LOG ("size %u, stride %u, n_lines %u", size, stride, n_lines);
   alloc = g_new0 (ConverterAlloc, 1);
-  alloc->data = g_malloc (stride * n_lines);
+  alloc->mem = g_malloc (stride * n_lines + CONVERTER_ALLOC_ALIGN - 1);
+  alloc->data = (guint8 *) GST_ROUND_UP_N ((guintptr) alloc->mem,
+      CONVERTER_ALLOC_ALIGN);
+  alloc->size = size;
   alloc->stride = stride;
   alloc->n_lines = n_lines;
   alloc->idx = 0;
@@ -684,7 +545,7 @@ converter_alloc_free (ConverterAlloc * alloc)
 {
   if (alloc->notify)
     alloc->notify (alloc->user_data);
-  g_free (alloc->data);
+  g_free (alloc->mem);
   g_free (alloc);
 }
 
@@ -696,7 +557,7 @@ setup_border_alloc (GstVideoConverter * convert, ConverterAlloc * alloc)
   if (convert->borderline) {
     for (i = 0; i < alloc->n_lines; i++)
       memcpy (&alloc->data[i * alloc->stride], convert->borderline,
-          alloc->stride);
+          alloc->size);
   }
 }
 
@@ -793,6 +654,7 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_DITHER_METHOD GST_VIDEO_DITHER_BAYER
 #define DEFAULT_OPT_DITHER_QUANTIZATION 1
 #define DEFAULT_OPT_ASYNC_TASKS FALSE
+#define DEFAULT_OPT_COLOR_LUT_SIZE 0
 
 #define GET_OPT_FILL_BORDER(c) get_opt_bool(c, \
     GST_VIDEO_CONVERTER_OPT_FILL_BORDER, DEFAULT_OPT_FILL_BORDER)
@@ -825,6 +687,8 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, DEFAULT_OPT_DITHER_QUANTIZATION)
 #define GET_OPT_ASYNC_TASKS(c) get_opt_bool(c, \
     GST_VIDEO_CONVERTER_OPT_ASYNC_TASKS, DEFAULT_OPT_ASYNC_TASKS)
+#define GET_OPT_COLOR_LUT_SIZE(c) get_opt_uint(c, \
+    GST_VIDEO_CONVERTER_OPT_COLOR_LUT_SIZE, DEFAULT_OPT_COLOR_LUT_SIZE)
 
 #define CHECK_ALPHA_COPY(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_COPY)
 #define CHECK_ALPHA_SET(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_SET)
@@ -837,6 +701,7 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 
 #define CHECK_GAMMA_NONE(c) (GET_OPT_GAMMA_MODE(c) == GST_VIDEO_GAMMA_MODE_NONE)
 #define CHECK_GAMMA_REMAP(c) (GET_OPT_GAMMA_MODE(c) == GST_VIDEO_GAMMA_MODE_REMAP)
+#define CHECK_COLOR_LUT(c) (CHECK_GAMMA_REMAP(c) && GET_OPT_COLOR_LUT_SIZE(c) >= 2)
 
 #define CHECK_PRIMARIES_NONE(c) (GET_OPT_PRIMARIES_MODE(c) == GST_VIDEO_PRIMARIES_MODE_NONE)
 #define CHECK_PRIMARIES_MERGE(c) (GET_OPT_PRIMARIES_MODE(c) == GST_VIDEO_PRIMARIES_MODE_MERGE_ONLY)
@@ -1562,13 +1427,223 @@ setup_gamma_encode (GstVideoConverter * convert, gint target_bits)
   }
 }
 
+/* 3D LUT for the complete color conversion. The table has @size points on
+ * each axis, for every point the 3 output components are stored as 16 bits
+ * values. The first input component is the slowest moving axis. */
+#define MAX_COLOR_LUT_SIZE 129
+#define LUT_FRAC_BITS      12
+
+static void
+color_matrix_apply (const MatrixData * m, const gdouble in[3], gdouble out[3])
+{
+  gint i;
+
+  for (i = 0; i < 3; i++)
+    out[i] = m->dm[i][0] * in[0] + m->dm[i][1] * in[1] +
+        m->dm[i][2] * in[2] + m->dm[i][3];
+}
+
+static void
+setup_color_lut (GstVideoConverter * convert)
+{
+  LutData *lut = &convert->lut;
+  MatrixData to_RGB, to_YUV;
+  GstVideoTransferFunction in_func, out_func;
+  gdouble in_max, out_max;
+  guint16 *t;
+  gint size, i, j, k, c;
+
+  size = MIN (GET_OPT_COLOR_LUT_SIZE (convert), MAX_COLOR_LUT_SIZE);
+
+  /* unpacked input values to R'G'B' in [0..1] */
+  color_matrix_set_identity (&to_RGB);
+  compute_matrix_to_RGB (convert, &to_RGB);
+  /* R'G'B' in [0..1] to packed output values */
+  color_matrix_set_identity (&to_YUV);
+  compute_matrix_to_YUV (convert, &to_YUV, FALSE);
+
+  in_func = convert->in_info.colorimetry.transfer;
+  out_func = convert->out_info.colorimetry.transfer;
+  in_max = (1 << convert->unpack_bits) - 1;
+  out_max = (1 << convert->pack_bits) - 1;
+
+  GST_LOG ("color LUT size %d, transfer %d -> %d", size, in_func, out_func);
+
+  lut->size = size;
+  /* 16.16 position of a 16 bits value on an axis, pre-shifted by 8 bits */
+  lut->scale = rint ((size - 1) * 65536.0 * 256.0 / 65535.0);
+  t = lut->table = g_malloc (sizeof (guint16) * size * size * size * 3);
+
+  for (i = 0; i < size; i++) {
+    for (j = 0; j < size; j++) {
+      for (k = 0; k < size; k++) {
+        gdouble in[3], rgb[3];
+
+        in[0] = i * in_max / (size - 1);
+        in[1] = j * in_max / (size - 1);
+        in[2] = k * in_max / (size - 1);
+
+        color_matrix_apply (&to_RGB, in, rgb);
+        for (c = 0; c < 3; c++)
+          rgb[c] = gst_video_transfer_function_decode (in_func,
+              CLAMP (rgb[c], 0.0, 1.0));
+
+        color_matrix_apply (&convert->convert_matrix, rgb, in);
+        for (c = 0; c < 3; c++)
+          in[c] = gst_video_transfer_function_encode (out_func,
+              CLAMP (in[c], 0.0, 1.0));
+
+        color_matrix_apply (&to_YUV, in, rgb);
+        for (c = 0; c < 3; c++)
+          *t++ = rint (CLAMP (rgb[c], 0.0, out_max) * 65535.0 / out_max);
+      }
+    }
+  }
+}
+
+static inline void
+lut_axis (const LutData * lut, guint v, gint * idx, gint * frac)
+{
+  guint pos = ((guint64) v * lut->scale) >> 8;
+
+  *idx = pos >> 16;
+  *frac = (pos & 0xffff) >> (16 - LUT_FRAC_BITS);
+  if (*idx >= lut->size - 1) {
+    *idx = lut->size - 2;
+    *frac = 1 << LUT_FRAC_BITS;
+  }
+}
+
+/* tetrahedral interpolation, the cube around the point is split in 6
+ * tetrahedra along the diagonal and only the 4 corners of the one containing
+ * the point are used */
+static inline void
+lut_interpolate (const LutData * lut, guint v0, guint v1, guint v2,
+    guint16 out[3])
+{
+  const gint s0 = lut->size * lut->size * 3, s1 = lut->size * 3, s2 = 3;
+  const guint16 *p0, *p1, *p2, *p3;
+  gint i0, i1, i2, f0, f1, f2, w1, w2, w3, c;
+
+  lut_axis (lut, v0, &i0, &f0);
+  lut_axis (lut, v1, &i1, &f1);
+  lut_axis (lut, v2, &i2, &f2);
+
+  p0 = lut->table + i0 * s0 + i1 * s1 + i2 * s2;
+  p3 = p0 + s0 + s1 + s2;
+
+  if (f0 >= f1) {
+    if (f1 >= f2) {
+      p1 = p0 + s0;
+      p2 = p1 + s1;
+      w1 = f0;
+      w2 = f1;
+      w3 = f2;
+    } else if (f0 >= f2) {
+      p1 = p0 + s0;
+      p2 = p1 + s2;
+      w1 = f0;
+      w2 = f2;
+      w3 = f1;
+    } else {
+      p1 = p0 + s2;
+      p2 = p1 + s0;
+      w1 = f2;
+      w2 = f0;
+      w3 = f1;
+    }
+  } else {
+    if (f2 >= f1) {
+      p1 = p0 + s2;
+      p2 = p1 + s1;
+      w1 = f2;
+      w2 = f1;
+      w3 = f0;
+    } else if (f2 >= f0) {
+      p1 = p0 + s1;
+      p2 = p1 + s2;
+      w1 = f1;
+      w2 = f2;
+      w3 = f0;
+    } else {
+      p1 = p0 + s1;
+      p2 = p1 + s0;
+      w1 = f1;
+      w2 = f0;
+      w3 = f2;
+    }
+  }
+
+  for (c = 0; c < 3; c++) {
+    gint v = (p0[c] << LUT_FRAC_BITS) + w1 * (p1[c] - p0[c]) +
+        w2 * (p2[c] - p1[c]) + w3 * (p3[c] - p2[c]);
+
+    out[c] = (v + (1 << (LUT_FRAC_BITS - 1))) >> LUT_FRAC_BITS;
+  }
+}
+
+static void
+convert_lut_line (GstVideoConverter * convert, gpointer dest, gpointer src,
+    gint width)
+{
+  const LutData *lut = &convert->lut;
+  guint16 out[3];
+  gint i;
+
+  if (convert->in_bits == 8) {
+    const guint8 *s = src;
+
+    for (i = 0; i < width * 4; i += 4) {
+      lut_interpolate (lut, s[i + 1] * 257, s[i + 2] * 257, s[i + 3] * 257,
+          out);
+      if (convert->out_bits == 8) {
+        guint8 *d = dest;
+
+        d[i + 0] = s[i + 0];
+        d[i + 1] = (out[0] * 255 + 32768) >> 16;
+        d[i + 2] = (out[1] * 255 + 32768) >> 16;
+        d[i + 3] = (out[2] * 255 + 32768) >> 16;
+      } else {
+        guint16 *d = dest;
+
+        d[i + 0] = s[i + 0] * 257;
+        d[i + 1] = out[0];
+        d[i + 2] = out[1];
+        d[i + 3] = out[2];
+      }
+    }
+  } else {
+    const guint16 *s = src;
+
+    for (i = 0; i < width * 4; i += 4) {
+      lut_interpolate (lut, s[i + 1], s[i + 2], s[i + 3], out);
+      if (convert->out_bits == 8) {
+        guint8 *d = dest;
+
+        d[i + 0] = s[i + 0] >> 8;
+        d[i + 1] = (out[0] * 255 + 32768) >> 16;
+        d[i + 2] = (out[1] * 255 + 32768) >> 16;
+        d[i + 3] = (out[2] * 255 + 32768) >> 16;
+      } else {
+        guint16 *d = dest;
+
+        d[i + 0] = s[i + 0];
+        d[i + 1] = out[0];
+        d[i + 2] = out[1];
+        d[i + 3] = out[2];
+      }
+    }
+  }
+}
+
 static GstLineCache *
 chain_convert_to_RGB (GstVideoConverter * convert, GstLineCache * prev,
     gint idx)
 {
   gboolean do_gamma;
 
-  do_gamma = CHECK_GAMMA_REMAP (convert);
+  /* with a color LUT this is all done in chain_convert() */
+  do_gamma = CHECK_GAMMA_REMAP (convert) && !CHECK_COLOR_LUT (convert);
 
   if (do_gamma) {
     gint scale;
@@ -1799,7 +1874,29 @@ chain_convert (GstVideoConverter * convert, GstLineCache * prev, gint idx)
   }
 
   do_gamma = CHECK_GAMMA_REMAP (convert);
-  if (!do_gamma) {
+  if (CHECK_COLOR_LUT (convert)) {
+    /* go straight from the unpacked to the packed values through the LUT,
+     * scaling is done on gamma encoded values like without gamma remap */
+    convert->in_bits = convert->unpack_bits;
+    convert->out_bits = convert->pack_bits;
+
+    if (idx == 0)
+      setup_color_lut (convert);
+
+    convert->current_bits = convert->pack_bits;
+    convert->current_format = convert->pack_format;
+    convert->current_pstride = convert->current_bits >> 1;
+
+    GST_LOG ("chain color LUT");
+    prev = convert->convert_lines[idx] = gst_line_cache_new (prev);
+    prev->write_input = TRUE;
+    prev->pass_alloc = convert->in_bits == convert->out_bits;
+    prev->n_lines = 1;
+    prev->stride = convert->current_pstride * convert->current_width;
+    gst_line_cache_set_need_line_func (prev,
+        do_convert_lut_lines, idx, convert, NULL);
+    return prev;
+  } else if (!do_gamma) {
 
     convert->in_bits = convert->unpack_bits;
     convert->out_bits = convert->pack_bits;
@@ -1957,7 +2054,7 @@ chain_convert_to_YUV (GstVideoConverter * convert, GstLineCache * prev,
 {
   gboolean do_gamma;
 
-  do_gamma = CHECK_GAMMA_REMAP (convert);
+  do_gamma = CHECK_GAMMA_REMAP (convert) && !CHECK_COLOR_LUT (convert);
 
   if (do_gamma) {
     gint scale;
@@ -2650,6 +2747,7 @@ gst_video_converter_free (GstVideoConverter * convert)
 
   g_free (convert->gamma_dec.gamma_table);
   g_free (convert->gamma_enc.gamma_table);
+  g_free (convert->lut.table);
 
   if (convert->tmpline) {
     for (i = 0; i < convert->conversion_runner->n_threads; i++)
@@ -3129,6 +3227,29 @@ do_convert_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   return TRUE;
 }
 
+static gboolean
+do_convert_lut_lines (GstLineCache * cache, gint idx, gint out_line,
+    gint in_line, gpointer user_data)
+{
+  GstVideoConverter *convert = user_data;
+  gpointer *lines, destline;
+  gint width;
+
+  lines = gst_line_cache_get_lines (cache->prev, idx, out_line, in_line, 1);
+
+  destline = lines[0];
+  if (convert->in_bits != convert->out_bits)
+    destline = gst_line_cache_alloc_line (cache, out_line);
+
+  width = MIN (convert->in_width, convert->out_width);
+
+  GST_LOG ("LUT line %d %p->%p", in_line, lines[0], destline);
+  convert_lut_line (convert, destline, lines[0], width);
+  gst_line_cache_add_line (cache, in_line, destline);
+
+  return TRUE;
+}
+
 static gboolean
 do_alpha_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
     gpointer user_data)
@@ -3783,6 +3904,148 @@ convert_I420_v210 (GstVideoConverter * convert, const GstVideoFrame * src,
   }
 }
 
+/* 4:2:0 planar <-> semiplanar only moves the chroma samples around, the
+ * chroma lines map one to one so interlacing doesn't matter */
+static void
+convert_I420_NV12_task (FConvertTask * task)
+{
+  gint i, j, cw;
+  const guint8 *su, *sv;
+  guint8 *duv;
+
+  cw = (task->width + 1) / 2;
+
+  for (i = task->height_0; i < task->height_1; i++) {
+    memcpy (FRAME_GET_Y_LINE (task->dest, i), FRAME_GET_Y_LINE (task->src, i),
+        task->width);
+
+    if (i & 1)
+      continue;
+
+    su = FRAME_GET_U_LINE (task->src, i >> 1);
+    sv = FRAME_GET_V_LINE (task->src, i >> 1);
+    if (GST_VIDEO_FRAME_FORMAT (task->dest) == GST_VIDEO_FORMAT_NV21) {
+      const guint8 *t = su;
+      su = sv;
+      sv = t;
+    }
+    duv = FRAME_GET_PLANE_LINE (task->dest, 1, i >> 1);
+
+    for (j = 0; j < cw; j++) {
+      duv[2 * j + 0] = su[j];
+      duv[2 * j + 1] = sv[j];
+    }
+  }
+}
+
+static void
+convert_I420_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  FConvertTask *tasks;
+  FConvertTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = convert->tasks[0] =
+      g_renew (FConvertTask, convert->tasks[0], n_threads);
+  tasks_p = convert->tasks_p[0] =
+      g_renew (FConvertTask *, convert->tasks_p[0], n_threads);
+
+  /* even so that each chroma line is done by one thread */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+
+    tasks[i].width = width;
+
+    tasks[i].height_0 = i * lines_per_thread;
+    tasks[i].height_1 = tasks[i].height_0 + lines_per_thread;
+    tasks[i].height_1 = MIN (height, tasks[i].height_1);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_I420_NV12_task, (gpointer) tasks_p);
+}
+
+static void
+convert_NV12_I420_task (FConvertTask * task)
+{
+  gint i, j, cw;
+  const guint8 *suv;
+  guint8 *du, *dv;
+
+  cw = (task->width + 1) / 2;
+
+  for (i = task->height_0; i < task->height_1; i++) {
+    memcpy (FRAME_GET_Y_LINE (task->dest, i), FRAME_GET_Y_LINE (task->src, i),
+        task->width);
+
+    if (i & 1)
+      continue;
+
+    suv = FRAME_GET_PLANE_LINE (task->src, 1, i >> 1);
+    du = FRAME_GET_U_LINE (task->dest, i >> 1);
+    dv = FRAME_GET_V_LINE (task->dest, i >> 1);
+    if (GST_VIDEO_FRAME_FORMAT (task->src) == GST_VIDEO_FORMAT_NV21) {
+      guint8 *t = du;
+      du = dv;
+      dv = t;
+    }
+
+    for (j = 0; j < cw; j++) {
+      du[j] = suv[2 * j + 0];
+      dv[j] = suv[2 * j + 1];
+    }
+  }
+}
+
+static void
+convert_NV12_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  FConvertTask *tasks;
+  FConvertTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = convert->tasks[0] =
+      g_renew (FConvertTask, convert->tasks[0], n_threads);
+  tasks_p = convert->tasks_p[0] =
+      g_renew (FConvertTask *, convert->tasks_p[0], n_threads);
+
+  /* even so that each chroma line is done by one thread */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+
+    tasks[i].width = width;
+
+    tasks[i].height_0 = i * lines_per_thread;
+    tasks[i].height_1 = tasks[i].height_0 + lines_per_thread;
+    tasks[i].height_1 = MIN (height, tasks[i].height_1);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_NV12_I420_task, (gpointer) tasks_p);
+}
+
 static void
 convert_YUY2_I420_task (FConvertTask * task)
 {
@@ -3860,6 +4123,110 @@ convert_YUY2_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
   }
 }
 
+static void
+convert_YUY2_NV12_task (FConvertTask * task)
+{
+  gint i, j, cw;
+  gint l1, l2;
+  gint y_off, u_off, v_off;
+  const guint8 *s1, *s2;
+  guint8 *d1, *d2, *duv;
+
+  /* byte offsets in the 4 bytes macro pixel */
+  if (GST_VIDEO_FRAME_FORMAT (task->src) == GST_VIDEO_FORMAT_UYVY) {
+    y_off = 1;
+    u_off = 0;
+    v_off = 2;
+  } else {
+    y_off = 0;
+    u_off = 1;
+    v_off = 3;
+  }
+  if (GST_VIDEO_FRAME_FORMAT (task->dest) == GST_VIDEO_FORMAT_NV21) {
+    gint t = u_off;
+    u_off = v_off;
+    v_off = t;
+  }
+
+  cw = (task->width + 1) / 2;
+
+  for (i = task->height_0; i < task->height_1; i += 2) {
+    GET_LINE_OFFSETS (task->interlaced, i, l1, l2);
+
+    s1 = FRAME_GET_LINE (task->src, l1);
+    s2 = FRAME_GET_LINE (task->src, l2);
+    d1 = FRAME_GET_Y_LINE (task->dest, l1);
+    d2 = FRAME_GET_Y_LINE (task->dest, l2);
+    duv = FRAME_GET_PLANE_LINE (task->dest, 1, i >> 1);
+
+    /* same chroma averaging as video_orc_convert_YUY2_I420 */
+    for (j = 0; j < cw; j++) {
+      d1[2 * j + 0] = s1[4 * j + y_off];
+      d1[2 * j + 1] = s1[4 * j + y_off + 2];
+      d2[2 * j + 0] = s2[4 * j + y_off];
+      d2[2 * j + 1] = s2[4 * j + y_off + 2];
+      duv[2 * j + 0] = (s1[4 * j + u_off] + s2[4 * j + u_off] + 1) >> 1;
+      duv[2 * j + 1] = (s1[4 * j + v_off] + s2[4 * j + v_off] + 1) >> 1;
+    }
+  }
+}
+
+static void
+convert_YUY2_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src)
+      && (GST_VIDEO_INFO_INTERLACE_MODE (&src->info) !=
+      GST_VIDEO_INTERLACE_MODE_ALTERNATE);
+  gint h2;
+  FConvertTask *tasks;
+  FConvertTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+
+  /* see convert_YUY2_I420() */
+  if (interlaced)
+    h2 = GST_ROUND_DOWN_4 (height);
+  else
+    h2 = GST_ROUND_DOWN_2 (height);
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = convert->tasks[0] =
+      g_renew (FConvertTask, convert->tasks[0], n_threads);
+  tasks_p = convert->tasks_p[0] =
+      g_renew (FConvertTask *, convert->tasks_p[0], n_threads);
+
+  lines_per_thread = GST_ROUND_UP_2 ((h2 + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+
+    tasks[i].interlaced = interlaced;
+    tasks[i].width = width;
+
+    tasks[i].height_0 = i * lines_per_thread;
+    tasks[i].height_1 = tasks[i].height_0 + lines_per_thread;
+    tasks[i].height_1 = MIN (h2, tasks[i].height_1);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_YUY2_NV12_task, (gpointer) tasks_p);
+
+  /* now handle last lines. For interlaced these are up to 3 */
+  if (h2 != height) {
+    for (i = h2; i < height; i++) {
+      UNPACK_FRAME (src, convert->tmpline[0], i, convert->in_x, width);
+      PACK_FRAME (dest, convert->tmpline[0], i, width);
+    }
+  }
+}
+
 static void
 convert_v210_I420_task (FConvertTask * task)
 {
@@ -7812,6 +8179,15 @@ static const VideoTransform transforms[] = {
   {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_FORMAT_Y444, TRUE, FALSE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_UYVY_Y444},
 
+  {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_NV12},
+  {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV21, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_NV12},
+  {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_NV12},
+  {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_FORMAT_NV21, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_NV12},
+
   {GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_I420, FALSE, FALSE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 1, 1, convert_AYUV_I420},
   {GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_YV12, FALSE, FALSE, TRUE, TRUE,
@@ -8000,6 +8376,24 @@ static const VideoTransform transforms[] = {
   {GST_VIDEO_FORMAT_YVU9, GST_VIDEO_FORMAT_YVU9, TRUE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
 
+  /* planar <-> semiplanar */
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV21, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV21, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV21, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV21, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+
   /* sempiplanar -> semiplanar */
   {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
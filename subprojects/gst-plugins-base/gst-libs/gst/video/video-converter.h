@@ -285,6 +285,21 @@ typedef enum {
  */
 #define GST_VIDEO_CONVERTER_OPT_ASYNC_TASKS   "GstVideoConverter.async-tasks"
 
+/**
+ * GST_VIDEO_CONVERTER_OPT_COLOR_LUT_SIZE:
+ *
+ * #G_TYPE_UINT, when the gamma mode is #GST_VIDEO_GAMMA_MODE_REMAP, precompute
+ * the complete color conversion, including the transfer functions and the
+ * primaries conversion, into a 3D LUT with this many points on each axis.
+ * The LUT is applied with tetrahedral interpolation, which is a lot cheaper
+ * than the per pixel conversion. Scaling is then done on gamma encoded
+ * values. Values larger than 129 are clamped, a value of 33 or 65 is a good
+ * choice. Default 0, which disables the LUT.
+ *
+ * Since: 1.26
+ */
+#define GST_VIDEO_CONVERTER_OPT_COLOR_LUT_SIZE   "GstVideoConverter.color-lut-size"
+
 typedef struct _GstVideoConverter GstVideoConverter;
 
 GST_VIDEO_API
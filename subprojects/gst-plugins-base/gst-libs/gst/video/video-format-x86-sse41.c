@@ -0,0 +1,269 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-format-x86-sse41.h"
+
+#if defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && \
+    defined (__SSE4_1__)
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+/* byte shuffle masks: W(n) selects 16 bits word n, D(n) selects word n
+ * zero extended to 32 bits and Z/ZD produce zero words/dwords */
+#define W(n)  (2 * (n)), (2 * (n) + 1)
+#define Z     -1, -1
+#define D(n)  W(n), Z
+#define ZD    Z, Z
+
+/* The kernels below only handle complete blocks, return the number of
+ * blocks they converted and expect the caller to deal with the remaining
+ * pixels. All input and output is little endian. */
+
+/* one group is 16 bytes of v210 and unpacks to 6 AYUV64 pixels */
+gint
+video_format_unpack_v210_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_groups)
+{
+  const __m128i mask = _mm_set1_epi32 (0x3ff);
+  const __m128i alpha = _mm_set1_epi64x (0xffff);
+  /* a = u0 y1 v2 y4 y0 u2 y3 v4, b = v0 y2 u4 y5 */
+  const __m128i sa0 = _mm_setr_epi8 (Z, W (4), W (0), Z, Z, W (1), W (0), Z);
+  const __m128i sb0 = _mm_setr_epi8 (Z, Z, Z, W (0), Z, Z, Z, W (0));
+  const __m128i sa1 = _mm_setr_epi8 (Z, Z, W (5), W (2), Z, W (6), W (5),
+      W (2));
+  const __m128i sb1 = _mm_setr_epi8 (Z, W (1), Z, Z, Z, Z, Z, Z);
+  const __m128i sa2 = _mm_setr_epi8 (Z, W (3), Z, W (7), Z, Z, Z, W (7));
+  const __m128i sb2 = _mm_setr_epi8 (Z, Z, W (2), Z, Z, W (3), W (2), Z);
+  gint i;
+
+  for (i = 0; i < n_groups; i++) {
+    __m128i w, a, b, o0, o1, o2;
+
+    w = _mm_loadu_si128 ((const __m128i *) (s + i * 16));
+    a = _mm_packus_epi32 (_mm_and_si128 (w, mask),
+        _mm_and_si128 (_mm_srli_epi32 (w, 10), mask));
+    b = _mm_and_si128 (_mm_srli_epi32 (w, 20), mask);
+    b = _mm_packus_epi32 (b, b);
+    a = _mm_slli_epi16 (a, 6);
+    b = _mm_slli_epi16 (b, 6);
+
+    if (replicate) {
+      a = _mm_or_si128 (a, _mm_srli_epi16 (a, 10));
+      b = _mm_or_si128 (b, _mm_srli_epi16 (b, 10));
+    }
+
+    o0 = _mm_or_si128 (_mm_shuffle_epi8 (a, sa0), _mm_shuffle_epi8 (b, sb0));
+    o1 = _mm_or_si128 (_mm_shuffle_epi8 (a, sa1), _mm_shuffle_epi8 (b, sb1));
+    o2 = _mm_or_si128 (_mm_shuffle_epi8 (a, sa2), _mm_shuffle_epi8 (b, sb2));
+
+    _mm_storeu_si128 ((__m128i *) (d + i * 24 + 0), _mm_or_si128 (o0, alpha));
+    _mm_storeu_si128 ((__m128i *) (d + i * 24 + 8), _mm_or_si128 (o1, alpha));
+    _mm_storeu_si128 ((__m128i *) (d + i * 24 + 16), _mm_or_si128 (o2, alpha));
+  }
+
+  return n_groups;
+}
+
+/* packs 6 AYUV64 pixels into one group of v210, using the chroma of the
+ * even pixels */
+gint
+video_format_pack_v210_sse41 (guint8 * d, const guint16 * s, gint n_groups)
+{
+  /* dwords of the group are lo | mid << 10 | hi << 20 with
+   * lo = u0 y1 v2 y4, mid = y0 u2 y3 v4 and hi = v0 y2 u4 y5 */
+  const __m128i l0 = _mm_setr_epi8 (D (2), D (5), ZD, ZD);
+  const __m128i m0 = _mm_setr_epi8 (D (1), ZD, ZD, ZD);
+  const __m128i h0 = _mm_setr_epi8 (D (3), ZD, ZD, ZD);
+  const __m128i l1 = _mm_setr_epi8 (ZD, ZD, D (3), ZD);
+  const __m128i m1 = _mm_setr_epi8 (ZD, D (2), D (5), ZD);
+  const __m128i h1 = _mm_setr_epi8 (ZD, D (1), ZD, ZD);
+  const __m128i l2 = _mm_setr_epi8 (ZD, ZD, ZD, D (1));
+  const __m128i m2 = _mm_setr_epi8 (ZD, ZD, ZD, D (3));
+  const __m128i h2 = _mm_setr_epi8 (ZD, ZD, D (2), D (5));
+  gint i;
+
+  for (i = 0; i < n_groups; i++) {
+    __m128i r0, r1, r2, lo, mid, hi;
+
+    r0 = _mm_loadu_si128 ((const __m128i *) (s + i * 24 + 0));
+    r1 = _mm_loadu_si128 ((const __m128i *) (s + i * 24 + 8));
+    r2 = _mm_loadu_si128 ((const __m128i *) (s + i * 24 + 16));
+    r0 = _mm_srli_epi16 (r0, 6);
+    r1 = _mm_srli_epi16 (r1, 6);
+    r2 = _mm_srli_epi16 (r2, 6);
+
+    lo = _mm_or_si128 (_mm_or_si128 (_mm_shuffle_epi8 (r0, l0),
+            _mm_shuffle_epi8 (r1, l1)), _mm_shuffle_epi8 (r2, l2));
+    mid = _mm_or_si128 (_mm_or_si128 (_mm_shuffle_epi8 (r0, m0),
+            _mm_shuffle_epi8 (r1, m1)), _mm_shuffle_epi8 (r2, m2));
+    hi = _mm_or_si128 (_mm_or_si128 (_mm_shuffle_epi8 (r0, h0),
+            _mm_shuffle_epi8 (r1, h1)), _mm_shuffle_epi8 (r2, h2));
+
+    lo = _mm_or_si128 (lo, _mm_slli_epi32 (mid, 10));
+    lo = _mm_or_si128 (lo, _mm_slli_epi32 (hi, 20));
+
+    _mm_storeu_si128 ((__m128i *) (d + i * 16), lo);
+  }
+
+  return n_groups;
+}
+
+/* one block is 4 pixels, Y0 U Y1 V Y2 U Y3 V */
+gint
+video_format_unpack_Y210_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  const __m128i alpha = _mm_set1_epi64x (0xffff);
+  const __m128i s0 = _mm_setr_epi8 (Z, W (0), W (1), W (3), Z, W (2), W (1),
+      W (3));
+  const __m128i s1 = _mm_setr_epi8 (Z, W (4), W (5), W (7), Z, W (6), W (5),
+      W (7));
+  gint i;
+
+  for (i = 0; i < n_blocks; i++) {
+    __m128i w;
+
+    w = _mm_loadu_si128 ((const __m128i *) (s + i * 16));
+    if (replicate)
+      w = _mm_or_si128 (w, _mm_srli_epi16 (w, 10));
+
+    _mm_storeu_si128 ((__m128i *) (d + i * 16 + 0),
+        _mm_or_si128 (_mm_shuffle_epi8 (w, s0), alpha));
+    _mm_storeu_si128 ((__m128i *) (d + i * 16 + 8),
+        _mm_or_si128 (_mm_shuffle_epi8 (w, s1), alpha));
+  }
+
+  return n_blocks;
+}
+
+/* one block is 4 pixels of 2:10:10:10 AVYU */
+gint
+video_format_unpack_Y410_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  const __m128i mask = _mm_set1_epi32 (0x3ff);
+  gint i;
+
+  for (i = 0; i < n_blocks; i++) {
+    __m128i w, a, y, u, v;
+
+    w = _mm_loadu_si128 ((const __m128i *) (s + i * 16));
+    u = _mm_slli_epi32 (_mm_and_si128 (w, mask), 6);
+    y = _mm_slli_epi32 (_mm_and_si128 (_mm_srli_epi32 (w, 10), mask), 6);
+    v = _mm_slli_epi32 (_mm_and_si128 (_mm_srli_epi32 (w, 20), mask), 6);
+    a = _mm_slli_epi32 (_mm_srli_epi32 (w, 30), 14);
+
+    if (replicate) {
+      u = _mm_or_si128 (u, _mm_srli_epi32 (u, 10));
+      y = _mm_or_si128 (y, _mm_srli_epi32 (y, 10));
+      v = _mm_or_si128 (v, _mm_srli_epi32 (v, 10));
+      a = _mm_or_si128 (a, _mm_srli_epi32 (a, 10));
+    }
+
+    a = _mm_or_si128 (a, _mm_slli_epi32 (y, 16));
+    u = _mm_or_si128 (u, _mm_slli_epi32 (v, 16));
+
+    _mm_storeu_si128 ((__m128i *) (d + i * 16 + 0), _mm_unpacklo_epi32 (a, u));
+    _mm_storeu_si128 ((__m128i *) (d + i * 16 + 8), _mm_unpackhi_epi32 (a, u));
+  }
+
+  return n_blocks;
+}
+
+/* one block is 8 pixels of P010, P012 or P016. @shift is the number of
+ * significant bits to replicate into the low bits or 0 to leave the
+ * samples untouched */
+gint
+video_format_unpack_P01x_LE_sse41 (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks)
+{
+  const __m128i alpha = _mm_set1_epi16 (-1);
+  const __m128i count = _mm_cvtsi32_si128 (shift);
+  gint i;
+
+  for (i = 0; i < n_blocks; i++) {
+    __m128i y, uv, ya, uv2;
+
+    y = _mm_loadu_si128 ((const __m128i *) (sy + i * 8));
+    uv = _mm_loadu_si128 ((const __m128i *) (suv + i * 8));
+    if (shift) {
+      y = _mm_or_si128 (y, _mm_srl_epi16 (y, count));
+      uv = _mm_or_si128 (uv, _mm_srl_epi16 (uv, count));
+    }
+
+    ya = _mm_unpacklo_epi16 (alpha, y);
+    uv2 = _mm_unpacklo_epi32 (uv, uv);
+    _mm_storeu_si128 ((__m128i *) (d + i * 32 + 0),
+        _mm_unpacklo_epi32 (ya, uv2));
+    _mm_storeu_si128 ((__m128i *) (d + i * 32 + 8),
+        _mm_unpackhi_epi32 (ya, uv2));
+
+    ya = _mm_unpackhi_epi16 (alpha, y);
+    uv2 = _mm_unpackhi_epi32 (uv, uv);
+    _mm_storeu_si128 ((__m128i *) (d + i * 32 + 16),
+        _mm_unpacklo_epi32 (ya, uv2));
+    _mm_storeu_si128 ((__m128i *) (d + i * 32 + 24),
+        _mm_unpackhi_epi32 (ya, uv2));
+  }
+
+  return n_blocks;
+}
+
+/* packs 8 AYUV64 pixels into the luma and, when @duv is not %NULL, the
+ * chroma plane of P010, P012 or P016 */
+gint
+video_format_pack_P01x_LE_sse41 (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks)
+{
+  const __m128i m = _mm_set1_epi16 (mask);
+  /* Y of both pixels in the first dword, U V of the first pixel in the
+   * second dword */
+  const __m128i sh = _mm_setr_epi8 (W (1), W (5), W (2), W (3), ZD, ZD);
+  gint i;
+
+  for (i = 0; i < n_blocks; i++) {
+    __m128i r0, r1, r2, r3, a, b;
+
+    r0 = _mm_loadu_si128 ((const __m128i *) (s + i * 32 + 0));
+    r1 = _mm_loadu_si128 ((const __m128i *) (s + i * 32 + 8));
+    r2 = _mm_loadu_si128 ((const __m128i *) (s + i * 32 + 16));
+    r3 = _mm_loadu_si128 ((const __m128i *) (s + i * 32 + 24));
+
+    r0 = _mm_shuffle_epi8 (_mm_and_si128 (r0, m), sh);
+    r1 = _mm_shuffle_epi8 (_mm_and_si128 (r1, m), sh);
+    r2 = _mm_shuffle_epi8 (_mm_and_si128 (r2, m), sh);
+    r3 = _mm_shuffle_epi8 (_mm_and_si128 (r3, m), sh);
+
+    a = _mm_unpacklo_epi32 (r0, r1);
+    b = _mm_unpacklo_epi32 (r2, r3);
+
+    _mm_storeu_si128 ((__m128i *) (dy + i * 8), _mm_unpacklo_epi64 (a, b));
+    if (duv)
+      _mm_storeu_si128 ((__m128i *) (duv + i * 8), _mm_unpackhi_epi64 (a, b));
+  }
+
+  return n_blocks;
+}
+
+#endif
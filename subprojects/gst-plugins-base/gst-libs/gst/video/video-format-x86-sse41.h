@@ -0,0 +1,49 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_FORMAT_X86_SSE41_H
+#define VIDEO_FORMAT_X86_SSE41_H
+
+#include <glib.h>
+
+G_GNUC_INTERNAL
+gint video_format_unpack_v210_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_groups);
+
+G_GNUC_INTERNAL
+gint video_format_pack_v210_sse41 (guint8 * d, const guint16 * s,
+    gint n_groups);
+
+G_GNUC_INTERNAL
+gint video_format_unpack_Y210_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+
+G_GNUC_INTERNAL
+gint video_format_unpack_Y410_sse41 (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+
+G_GNUC_INTERNAL
+gint video_format_unpack_P01x_LE_sse41 (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks);
+
+G_GNUC_INTERNAL
+gint video_format_pack_P01x_LE_sse41 (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks);
+
+#endif /* VIDEO_FORMAT_X86_SSE41_H */
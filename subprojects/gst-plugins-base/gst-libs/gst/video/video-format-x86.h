@@ -0,0 +1,38 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "video-format-x86-sse41.h"
+
+static void
+video_format_check_x86 (const gchar * option)
+{
+  if (!strcmp (option, "sse41")) {
+#if defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && HAVE_SSE41
+    GST_DEBUG ("enable SSE41 optimisations");
+    unpack_v210_blocks = video_format_unpack_v210_sse41;
+    pack_v210_blocks = video_format_pack_v210_sse41;
+    unpack_Y210_blocks = video_format_unpack_Y210_sse41;
+    unpack_Y410_blocks = video_format_unpack_Y410_sse41;
+    unpack_P01x_LE_blocks = video_format_unpack_P01x_LE_sse41;
+    pack_P01x_LE_blocks = video_format_pack_P01x_LE_sse41;
+#else
+    GST_DEBUG ("SSE41 optimisations not enabled");
+#endif
+  }
+}
@@ -29,6 +29,10 @@
 #include "video-format.h"
 #include "video-orc.h"
 
+#ifdef HAVE_ORC
+#include <orc/orc.h>
+#endif
+
 #ifndef restrict
 #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
 /* restrict should be available */
@@ -86,6 +90,181 @@
 
 #define IS_ALIGNED(x,n) ((((guintptr)(x)&((n)-1))) == 0)
 
+/* kernels for complete blocks of pixels of the 10, 12 and 16 bits formats.
+ * They return the number of blocks they converted and the pack and unpack
+ * functions handle the remaining pixels. The pointers initially point to
+ * resolvers that select vectorized versions when the CPU supports them, or
+ * versions that don't convert anything, the first time they are called, so
+ * that the format lookups and conversions don't need to check for it. */
+typedef gint (*VideoFormatUnpackPackedFunc) (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+typedef gint (*VideoFormatPackV210Func) (guint8 * d, const guint16 * s,
+    gint n_groups);
+typedef gint (*VideoFormatUnpackP01xFunc) (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks);
+typedef gint (*VideoFormatPackP01xFunc) (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks);
+
+static void video_format_init (void);
+
+static gint
+resolve_unpack_v210_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+static gint
+resolve_pack_v210_blocks (guint8 * d, const guint16 * s, gint n_groups);
+static gint
+resolve_unpack_Y210_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+static gint
+resolve_unpack_Y410_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks);
+static gint
+resolve_unpack_P01x_LE_blocks (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks);
+static gint
+resolve_pack_P01x_LE_blocks (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks);
+
+static VideoFormatUnpackPackedFunc unpack_v210_blocks =
+    resolve_unpack_v210_blocks;
+static VideoFormatPackV210Func pack_v210_blocks = resolve_pack_v210_blocks;
+static VideoFormatUnpackPackedFunc unpack_Y210_blocks =
+    resolve_unpack_Y210_blocks;
+static VideoFormatUnpackPackedFunc unpack_Y410_blocks =
+    resolve_unpack_Y410_blocks;
+static VideoFormatUnpackP01xFunc unpack_P01x_LE_blocks =
+    resolve_unpack_P01x_LE_blocks;
+static VideoFormatPackP01xFunc pack_P01x_LE_blocks =
+    resolve_pack_P01x_LE_blocks;
+
+static gint
+resolve_unpack_v210_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  video_format_init ();
+  return unpack_v210_blocks (d, s, replicate, n_blocks);
+}
+
+static gint
+resolve_pack_v210_blocks (guint8 * d, const guint16 * s, gint n_groups)
+{
+  video_format_init ();
+  return pack_v210_blocks (d, s, n_groups);
+}
+
+static gint
+resolve_unpack_Y210_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  video_format_init ();
+  return unpack_Y210_blocks (d, s, replicate, n_blocks);
+}
+
+static gint
+resolve_unpack_Y410_blocks (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  video_format_init ();
+  return unpack_Y410_blocks (d, s, replicate, n_blocks);
+}
+
+static gint
+resolve_unpack_P01x_LE_blocks (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks)
+{
+  video_format_init ();
+  return unpack_P01x_LE_blocks (d, sy, suv, shift, n_blocks);
+}
+
+static gint
+resolve_pack_P01x_LE_blocks (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks)
+{
+  video_format_init ();
+  return pack_P01x_LE_blocks (dy, duv, s, mask, n_blocks);
+}
+
+/* used without vectorized versions, the C code converts all pixels */
+static gint
+unpack_packed_blocks_none (guint16 * d, const guint8 * s,
+    gboolean replicate, gint n_blocks)
+{
+  return 0;
+}
+
+static gint
+pack_v210_blocks_none (guint8 * d, const guint16 * s, gint n_groups)
+{
+  return 0;
+}
+
+static gint
+unpack_P01x_LE_blocks_none (guint16 * d, const guint16 * sy,
+    const guint16 * suv, gint shift, gint n_blocks)
+{
+  return 0;
+}
+
+static gint
+pack_P01x_LE_blocks_none (guint16 * dy, guint16 * duv,
+    const guint16 * s, guint16 mask, gint n_blocks)
+{
+  return 0;
+}
+
+#if defined HAVE_ORC && !defined DISABLE_ORC
+# if defined (__i386__) || defined (__x86_64__)
+#  define CHECK_X86
+#  include "video-format-x86.h"
+# endif
+#endif
+
+static void
+video_format_init (void)
+{
+  static gsize init_gonce = 0;
+
+  if (g_once_init_enter (&init_gonce)) {
+    unpack_v210_blocks = unpack_packed_blocks_none;
+    pack_v210_blocks = pack_v210_blocks_none;
+    unpack_Y210_blocks = unpack_packed_blocks_none;
+    unpack_Y410_blocks = unpack_packed_blocks_none;
+    unpack_P01x_LE_blocks = unpack_P01x_LE_blocks_none;
+    pack_P01x_LE_blocks = pack_P01x_LE_blocks_none;
+
+#if defined HAVE_ORC && !defined DISABLE_ORC
+    orc_init ();
+    {
+      OrcTarget *target = orc_target_get_default ();
+      gint i;
+
+      if (target) {
+        const gchar *name;
+        unsigned int flags = orc_target_get_default_flags (target);
+
+        for (i = -1; i < 32; ++i) {
+          if (i == -1) {
+            name = orc_target_get_name (target);
+            GST_DEBUG ("target %s, default flags %08x", name, flags);
+          } else if (flags & (1U << i)) {
+            name = orc_target_get_flag_name (target, i);
+            GST_DEBUG ("target flag %s", name);
+          } else
+            name = NULL;
+
+          if (name) {
+#ifdef CHECK_X86
+            video_format_check_x86 (name);
+#endif
+          }
+        }
+      }
+    }
+#endif
+    g_once_init_leave (&init_gonce, 1);
+  }
+}
+
 #define PACK_420 GST_VIDEO_FORMAT_AYUV, unpack_planar_420, 1, pack_planar_420
 static void
 unpack_planar_420 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
@@ -571,7 +750,10 @@ unpack_v210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
   if (x != 0)
     GST_FIXME ("Horizontal offsets are not supported for v210");
 
-  for (i = 0; i < width; i += 6) {
+  i = unpack_v210_blocks (d, s, !(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE),
+      width / 6) * 6;
+
+  for (; i < width; i += 6) {
     a0 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 0);
     a1 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 4);
     a2 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 8);
@@ -661,7 +843,9 @@ pack_v210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
   guint16 u0, u1, u2;
   guint16 v0, v1, v2;
 
-  for (i = 0; i < width; i += 6) {
+  i = pack_v210_blocks (d, s, width / 6) * 6;
+
+  for (; i < width; i += 6) {
     y1 = y2 = y3 = y4 = y5 = 0;
     u1 = u2 = v1 = v2 = 0;
 
@@ -787,7 +971,10 @@ unpack_Y210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     width--;
   }
 
-  for (i = 0; i < width / 2; i++) {
+  i = unpack_Y210_blocks (d, s, !(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE),
+      width / 4) * 2;
+
+  for (; i < width / 2; i++) {
     Y0 = GST_READ_UINT16_LE (s + i * 8 + 0);
     U = GST_READ_UINT16_LE (s + i * 8 + 2);
     V = GST_READ_UINT16_LE (s + i * 8 + 6);
@@ -795,6 +982,7 @@ unpack_Y210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 
     if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
       Y0 |= (Y0 >> 10);
+      Y1 |= (Y1 >> 10);
       U |= (U >> 10);
       V |= (V >> 10);
     }
@@ -871,7 +1059,10 @@ unpack_Y410 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 
   s += x * 4;
 
-  for (i = 0; i < width; i++) {
+  i = unpack_Y410_blocks (d, s, !(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE),
+      width / 4) * 4;
+
+  for (; i < width; i++) {
     AVYU = GST_READ_UINT32_LE (s + 4 * i);
 
     U = ((AVYU >> 0) & 0x3ff) << 6;
@@ -5133,7 +5324,10 @@ unpack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     suv += 2;
   }
 
-  for (i = 0; i < width / 2; i++) {
+  i = unpack_P01x_LE_blocks (d, sy, suv,
+      flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE ? 0 : 10, width / 8) * 4;
+
+  for (; i < width / 2; i++) {
     Y0 = GST_READ_UINT16_LE (sy + 2 * i);
     Y1 = GST_READ_UINT16_LE (sy + 2 * i + 1);
     U = GST_READ_UINT16_LE (suv + 2 * i);
@@ -5182,15 +5376,18 @@ pack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
+  int i, n;
   gint uv = GET_UV_420 (y, flags);
   guint16 *restrict dy = GET_PLANE_LINE (0, y);
   guint16 *restrict duv = GET_PLANE_LINE (1, uv);
   guint16 Y0, Y1, U, V;
   const guint16 *restrict s = src;
 
+  n = pack_P01x_LE_blocks (dy, IS_CHROMA_LINE_420 (y, flags) ? duv : NULL, s,
+      0xffc0, width / 8);
+
   if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width / 2; i++) {
+    for (i = n * 4; i < width / 2; i++) {
       Y0 = s[i * 8 + 1] & 0xffc0;
       Y1 = s[i * 8 + 5] & 0xffc0;
       U = s[i * 8 + 2] & 0xffc0;
@@ -5213,7 +5410,7 @@ pack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
       GST_WRITE_UINT16_LE (duv + i + 1, V);
     }
   } else {
-    for (i = 0; i < width; i++) {
+    for (i = n * 8; i < width; i++) {
       Y0 = s[i * 4 + 1] & 0xffc0;
       GST_WRITE_UINT16_LE (dy + i, Y0);
     }
@@ -6144,7 +6341,9 @@ unpack_P016_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     suv += 2;
   }
 
-  for (i = 0; i < width / 2; i++) {
+  i = unpack_P01x_LE_blocks (d, sy, suv, 0, width / 8) * 4;
+
+  for (; i < width / 2; i++) {
     Y0 = GST_READ_UINT16_LE (sy + 2 * i);
     Y1 = GST_READ_UINT16_LE (sy + 2 * i + 1);
     U = GST_READ_UINT16_LE (suv + 2 * i);
@@ -6180,15 +6379,18 @@ pack_P016_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
+  int i, n;
   gint uv = GET_UV_420 (y, flags);
   guint16 *restrict dy = GET_PLANE_LINE (0, y);
   guint16 *restrict duv = GET_PLANE_LINE (1, uv);
   guint16 Y0, Y1, U, V;
   const guint16 *restrict s = src;
 
+  n = pack_P01x_LE_blocks (dy, IS_CHROMA_LINE_420 (y, flags) ? duv : NULL, s,
+      0xffff, width / 8);
+
   if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width / 2; i++) {
+    for (i = n * 4; i < width / 2; i++) {
       Y0 = s[i * 8 + 1];
       Y1 = s[i * 8 + 5];
       U = s[i * 8 + 2];
@@ -6211,7 +6413,7 @@ pack_P016_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
       GST_WRITE_UINT16_LE (duv + i + 1, V);
     }
   } else {
-    for (i = 0; i < width; i++) {
+    for (i = n * 8; i < width; i++) {
       Y0 = s[i * 4 + 1];
       GST_WRITE_UINT16_LE (dy + i, Y0);
     }
@@ -6377,7 +6579,10 @@ unpack_P012_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     suv += 2;
   }
 
-  for (i = 0; i < width / 2; i++) {
+  i = unpack_P01x_LE_blocks (d, sy, suv,
+      flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE ? 0 : 12, width / 8) * 4;
+
+  for (; i < width / 2; i++) {
     Y0 = GST_READ_UINT16_LE (sy + 2 * i);
     Y1 = GST_READ_UINT16_LE (sy + 2 * i + 1);
     U = GST_READ_UINT16_LE (suv + 2 * i);
@@ -6426,15 +6631,18 @@ pack_P012_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
+  int i, n;
   gint uv = GET_UV_420 (y, flags);
   guint16 *restrict dy = GET_PLANE_LINE (0, y);
   guint16 *restrict duv = GET_PLANE_LINE (1, uv);
   guint16 Y0, Y1, U, V;
   const guint16 *restrict s = src;
 
+  n = pack_P01x_LE_blocks (dy, IS_CHROMA_LINE_420 (y, flags) ? duv : NULL, s,
+      0xfff0, width / 8);
+
   if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width / 2; i++) {
+    for (i = n * 4; i < width / 2; i++) {
       Y0 = s[i * 8 + 1] & 0xfff0;
       Y1 = s[i * 8 + 5] & 0xfff0;
       U = s[i * 8 + 2] & 0xfff0;
@@ -6457,7 +6665,7 @@ pack_P012_LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
       GST_WRITE_UINT16_LE (duv + i + 1, V);
     }
   } else {
-    for (i = 0; i < width; i++) {
+    for (i = n * 8; i < width; i++) {
       Y0 = s[i * 4 + 1] & 0xfff0;
       GST_WRITE_UINT16_LE (dy + i, Y0);
     }
@@ -30,6 +30,11 @@
 #include "video-frame.h"
 #include "video-tile.h"
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
+
+/* Set when all planes of a frame with a GstVideoMeta were mapped with a single
+ * map of the buffer in frame->map[0] */
+#define FRAME_SINGLE_MAP(frame) ((frame)->_gst_reserved[0])
 
 #define CAT_PERFORMANCE video_frame_get_perf_category()
 
@@ -99,11 +104,32 @@ gst_video_frame_map_id (GstVideoFrame * frame, const GstVideoInfo * info,
     frame->id = meta->id;
     frame->flags = meta->flags;
 
-    for (i = 0; i < meta->n_planes; i++) {
-      frame->info.offset[i] = meta->offset[i];
-      if (!gst_video_meta_map (meta, i, &frame->map[i], &frame->data[i],
-              &frame->info.stride[i], flags))
-        goto frame_map_failed;
+    if (__gst_video_meta_has_default_map (meta) && meta->buffer == buffer &&
+        gst_buffer_n_memory (buffer) == 1) {
+      /* all planes are in the same memory, which is what the default map
+       * function would map for each of them, map it only once */
+      if (!gst_buffer_map (buffer, &frame->map[0], flags))
+        goto map_failed;
+
+      for (i = 0; i < meta->n_planes; i++) {
+        if (meta->offset[i] >= frame->map[0].size)
+          goto invalid_offset;
+
+        frame->info.offset[i] = meta->offset[i];
+        frame->info.stride[i] = meta->stride[i];
+        frame->data[i] = frame->map[0].data + meta->offset[i];
+        if (i > 0)
+          frame->map[i] = frame->map[0];
+      }
+      FRAME_SINGLE_MAP (frame) = GINT_TO_POINTER (TRUE);
+    } else {
+      for (i = 0; i < meta->n_planes; i++) {
+        frame->info.offset[i] = meta->offset[i];
+        if (!gst_video_meta_map (meta, i, &frame->map[i], &frame->data[i],
+                &frame->info.stride[i], flags))
+          goto frame_map_failed;
+      }
+      FRAME_SINGLE_MAP (frame) = NULL;
     }
   } else {
     /* no metadata, we really need to have the metadata when the id is
@@ -125,6 +151,7 @@ gst_video_frame_map_id (GstVideoFrame * frame, const GstVideoInfo * info,
     for (i = 0; i < info->finfo->n_planes; i++) {
       frame->data[i] = frame->map[0].data + info->offset[i];
     }
+    FRAME_SINGLE_MAP (frame) = NULL;
   }
   frame->buffer = buffer;
   if ((flags & GST_VIDEO_FRAME_MAP_FLAG_NO_REF) == 0)
@@ -174,6 +201,15 @@ frame_map_failed:
 map_failed:
   {
     GST_ERROR ("failed to map buffer");
+    memset (frame, 0, sizeof (GstVideoFrame));
+    return FALSE;
+  }
+invalid_offset:
+  {
+    GST_ERROR ("plane %d, no memory at offset %" G_GSIZE_FORMAT, i,
+        meta->offset[i]);
+    gst_buffer_unmap (buffer, &frame->map[0]);
+    memset (frame, 0, sizeof (GstVideoFrame));
     return FALSE;
   }
 invalid_size:
@@ -272,7 +308,7 @@ gst_video_frame_unmap (GstVideoFrame * frame)
   if (G_UNLIKELY (buffer == NULL))
     return;
 
-  if (meta) {
+  if (meta && !FRAME_SINGLE_MAP (frame)) {
     for (i = 0; i < frame->info.finfo->n_planes; i++) {
       gst_video_meta_unmap (meta, i, &frame->map[i]);
     }
@@ -61,6 +61,7 @@
 #include "video-overlay-composition.h"
 #include "video-blend.h"
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
 #include <string.h>
 
 struct _GstVideoOverlayComposition
@@ -443,6 +444,10 @@ gst_video_overlay_composition_get_rectangle (GstVideoOverlayComposition * comp,
   return comp->rectangles[n];
 }
 
+static GstBuffer *gst_video_overlay_rectangle_get_pixels_raw_internal
+    (GstVideoOverlayRectangle * rectangle, GstVideoOverlayFormatFlags flags,
+    gboolean unscaled, GstVideoFormat wanted_format);
+
 static gboolean
 gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
 {
@@ -463,25 +468,54 @@ gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
  * Since @video_buf data is read and will be modified, it ought be
  * mapped with flag GST_MAP_READWRITE.
  */
+gboolean
+gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
+    GstVideoFrame * video_buf)
+{
+  return gst_video_overlay_composition_blend_with_pool (comp, video_buf, 1,
+      NULL);
+}
+
+/**
+ * gst_video_overlay_composition_blend_with_pool:
+ * @comp: a #GstVideoOverlayComposition
+ * @video_buf: a #GstVideoFrame containing raw video data in a
+ *             supported format. It should be mapped using GST_MAP_READWRITE
+ * @n_threads: the number of threads to use, or 0 to use one thread per CPU
+ * @pool: (transfer none) (nullable): a #GstTaskPool to spawn the threads
+ *        from, or %NULL to use a pool that only exists for this call
+ *
+ * Like gst_video_overlay_composition_blend() but splits each rectangle in
+ * stripes of lines that are blended in parallel on @n_threads threads.
+ *
+ * Passing a #GstSharedTaskPool that is kept around avoids creating new
+ * threads for every frame.
+ *
+ * Returns: %TRUE if all rectangles could be blended
+ *
+ * Since: 1.26
+ */
 /* FIXME: formats with more than 8 bit per component which get unpacked into
  * ARGB64 or AYUV64 (such as v210, v216, UYVP, GRAY16_LE and GRAY16_BE)
  * are not supported yet by the code in video-blend.c.
  */
 gboolean
-gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
-    GstVideoFrame * video_buf)
+gst_video_overlay_composition_blend_with_pool (GstVideoOverlayComposition *
+    comp, GstVideoFrame * video_buf, guint n_threads, GstTaskPool * pool)
 {
+  GstParallelizedTaskRunner *runner = NULL;
   GstVideoInfo scaled_info;
   GstVideoInfo *vinfo;
   GstVideoFrame rectangle_frame;
   GstVideoFormat fmt;
-  GstBuffer *pixels = NULL;
+  GstBuffer *pixels;
   gboolean ret = TRUE;
   guint n, num;
   int w, h;
 
   g_return_val_if_fail (GST_IS_VIDEO_OVERLAY_COMPOSITION (comp), FALSE);
   g_return_val_if_fail (video_buf != NULL, FALSE);
+  g_return_val_if_fail (pool == NULL || GST_IS_TASK_POOL (pool), FALSE);
 
   w = GST_VIDEO_FRAME_WIDTH (video_buf);
   h = GST_VIDEO_FRAME_HEIGHT (video_buf);
@@ -489,11 +523,14 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
 
   num = comp->num_rectangles;
   GST_LOG ("Blending composition %p with %u rectangles onto video buffer %p "
-      "(%ux%u, format %u)", comp, num, video_buf, w, h, fmt);
+      "(%ux%u, format %u) with %u threads", comp, num, video_buf, w, h, fmt,
+      n_threads);
+
+  if (num > 0 && n_threads != 1)
+    runner = gst_parallelized_task_runner_new (n_threads, pool, FALSE);
 
   for (n = 0; n < num; ++n) {
     GstVideoOverlayRectangle *rect;
-    gboolean needs_scaling;
 
     rect = comp->rectangles[n];
 
@@ -501,29 +538,37 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
         GST_VIDEO_INFO_WIDTH (&rect->info), GST_VIDEO_INFO_HEIGHT (&rect->info),
         GST_VIDEO_INFO_FORMAT (&rect->info));
 
-    needs_scaling = gst_video_overlay_rectangle_needs_scaling (rect);
-    if (needs_scaling) {
-      gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
-          rect->render_height, rect->render_width, &scaled_info, &pixels);
+    /* the scaled pixels are cached in the rectangle, so they are reused for
+     * as long as the same composition is blended on consecutive frames.
+     * Global alpha is applied while blending. */
+    pixels = gst_video_overlay_rectangle_get_pixels_raw_internal (rect,
+        (rect->flags & GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA) |
+        GST_VIDEO_OVERLAY_FORMAT_FLAG_GLOBAL_ALPHA, FALSE,
+        GST_VIDEO_INFO_FORMAT (&rect->info));
+
+    if (gst_video_overlay_rectangle_needs_scaling (rect)) {
+      gst_video_info_set_format (&scaled_info,
+          GST_VIDEO_INFO_FORMAT (&rect->info), rect->render_width,
+          rect->render_height);
+      GST_VIDEO_INFO_FLAGS (&scaled_info) = GST_VIDEO_INFO_FLAGS (&rect->info);
       vinfo = &scaled_info;
     } else {
-      pixels = gst_buffer_ref (rect->pixels);
       vinfo = &rect->info;
     }
 
     gst_video_frame_map (&rectangle_frame, vinfo, pixels, GST_MAP_READ);
 
-    ret = gst_video_blend (video_buf, &rectangle_frame, rect->x, rect->y,
-        rect->global_alpha);
+    ret = __gst_video_blend_with_runner (video_buf, &rectangle_frame, rect->x,
+        rect->y, rect->global_alpha, runner);
     gst_video_frame_unmap (&rectangle_frame);
     if (!ret) {
       GST_WARNING ("Could not blend overlay rectangle onto video buffer");
     }
-
-    /* FIXME: should cache scaled pixels in the rectangle struct */
-    gst_buffer_unref (pixels);
   }
 
+  if (runner)
+    gst_parallelized_task_runner_free (runner);
+
   return ret;
 }
 
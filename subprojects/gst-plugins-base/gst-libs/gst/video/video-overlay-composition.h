@@ -263,6 +263,12 @@ GST_VIDEO_API
 gboolean                     gst_video_overlay_composition_blend         (GstVideoOverlayComposition * comp,
                                                                           GstVideoFrame              * video_buf);
 
+GST_VIDEO_API
+gboolean                     gst_video_overlay_composition_blend_with_pool (GstVideoOverlayComposition * comp,
+                                                                            GstVideoFrame              * video_buf,
+                                                                            guint                        n_threads,
+                                                                            GstTaskPool                * pool);
+
 /* attach/retrieve composition from buffers */
 
 #define GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE \
@@ -0,0 +1,122 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-scaler-x86-sse41.h"
+
+#if defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && \
+    defined (__SSE4_1__)
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+/* must match the rounding of video_orc_resample_scaletaps_u16 */
+#define SCALE_U16             12
+#define SCALETAPS_U16_ROUND   ((1 << SCALE_U16) - 1)
+
+static inline guint16
+scale_u16 (gint32 sum)
+{
+  return CLAMP ((sum + SCALETAPS_U16_ROUND) >> SCALE_U16, 0, 65535);
+}
+
+static inline __m128i
+scale_u16_sse41 (__m128i lo, __m128i hi)
+{
+  const __m128i round = _mm_set1_epi32 (SCALETAPS_U16_ROUND);
+
+  lo = _mm_srai_epi32 (_mm_add_epi32 (lo, round), SCALE_U16);
+  hi = _mm_srai_epi32 (_mm_add_epi32 (hi, round), SCALE_U16);
+
+  return _mm_packus_epi32 (lo, hi);
+}
+
+/* Accumulates all taps for 8 pixels in registers and writes the result in
+ * one pass instead of going through a temporary line for each tap */
+void
+video_scale_v_ntap_u16_sse41 (guint16 * d, gpointer srcs[], gint src_inc,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  gint i, j;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    __m128i lo = _mm_setzero_si128 ();
+    __m128i hi = _mm_setzero_si128 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint16 *s = (const guint16 *) srcs[j * src_inc] + i;
+      __m128i t = _mm_set1_epi32 (taps[j]);
+      __m128i p = _mm_loadu_si128 ((const __m128i *) s);
+
+      lo = _mm_add_epi32 (lo, _mm_mullo_epi32 (_mm_cvtepu16_epi32 (p), t));
+      hi = _mm_add_epi32 (hi,
+          _mm_mullo_epi32 (_mm_cvtepu16_epi32 (_mm_srli_si128 (p, 8)), t));
+    }
+    _mm_storeu_si128 ((__m128i *) (d + i), scale_u16_sse41 (lo, hi));
+  }
+
+  for (; i < count; i++) {
+    gint32 sum = 0;
+
+    for (j = 0; j < n_taps; j++)
+      sum += ((const guint16 *) srcs[j * src_inc])[i] * taps[j];
+    d[i] = scale_u16 (sum);
+  }
+}
+
+/* @pixels and @taps contain @n_taps blocks of @count elements, one block
+ * for each tap, as prepared by video_scale_h_ntap_u16() */
+void
+video_scale_h_ntap_u16_sse41 (guint16 * d, const guint16 * pixels,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  gint i, j;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    __m128i lo = _mm_setzero_si128 ();
+    __m128i hi = _mm_setzero_si128 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint16 *s = pixels + j * count + i;
+      const gint16 *t = taps + j * count + i;
+      __m128i p = _mm_loadu_si128 ((const __m128i *) s);
+      __m128i c = _mm_loadu_si128 ((const __m128i *) t);
+
+      lo = _mm_add_epi32 (lo, _mm_mullo_epi32 (_mm_cvtepu16_epi32 (p),
+              _mm_cvtepi16_epi32 (c)));
+      hi = _mm_add_epi32 (hi,
+          _mm_mullo_epi32 (_mm_cvtepu16_epi32 (_mm_srli_si128 (p, 8)),
+              _mm_cvtepi16_epi32 (_mm_srli_si128 (c, 8))));
+    }
+    _mm_storeu_si128 ((__m128i *) (d + i), scale_u16_sse41 (lo, hi));
+  }
+
+  for (; i < count; i++) {
+    gint32 sum = 0;
+
+    for (j = 0; j < n_taps; j++)
+      sum += pixels[j * count + i] * taps[j * count + i];
+    d[i] = scale_u16 (sum);
+  }
+}
+
+#endif
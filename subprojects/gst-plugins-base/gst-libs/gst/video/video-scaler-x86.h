@@ -0,0 +1,34 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "video-scaler-x86-sse41.h"
+
+static void
+video_scaler_check_x86 (const gchar * option)
+{
+  if (!strcmp (option, "sse41")) {
+#if defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H) && HAVE_SSE41
+    GST_DEBUG ("enable SSE41 optimisations");
+    resample_v_ntap_u16 = video_scale_v_ntap_u16_sse41;
+    resample_h_ntap_u16 = video_scale_h_ntap_u16_sse41;
+#else
+    GST_DEBUG ("SSE41 optimisations not enabled");
+#endif
+  }
+}
@@ -35,6 +35,10 @@
  *
  */
 
+#ifdef HAVE_ORC
+#include <orc/orc.h>
+#endif
+
 #ifndef DISABLE_ORC
 #include <orc/orcfunctions.h>
 #else
@@ -105,6 +109,62 @@ struct _GstVideoScaler
   gpointer tmpline2;
 };
 
+/* fused n-tap kernels that accumulate all taps in one pass, selected at
+ * runtime in video_scaler_init() when the CPU supports them */
+typedef void (*VideoScaleVNtapU16Func) (guint16 * d, gpointer srcs[],
+    gint src_inc, const gint16 * taps, gint n_taps, gint count);
+typedef void (*VideoScaleHNtapU16Func) (guint16 * d, const guint16 * pixels,
+    const gint16 * taps, gint n_taps, gint count);
+
+static VideoScaleVNtapU16Func resample_v_ntap_u16 = NULL;
+static VideoScaleHNtapU16Func resample_h_ntap_u16 = NULL;
+
+#if defined HAVE_ORC && !defined DISABLE_ORC
+# if defined (__i386__) || defined (__x86_64__)
+#  define CHECK_X86
+#  include "video-scaler-x86.h"
+# endif
+#endif
+
+static void
+video_scaler_init (void)
+{
+  static gsize init_gonce = 0;
+
+  if (g_once_init_enter (&init_gonce)) {
+#if defined HAVE_ORC && !defined DISABLE_ORC
+    orc_init ();
+    {
+      OrcTarget *target = orc_target_get_default ();
+      gint i;
+
+      if (target) {
+        const gchar *name;
+        unsigned int flags = orc_target_get_default_flags (target);
+
+        for (i = -1; i < 32; ++i) {
+          if (i == -1) {
+            name = orc_target_get_name (target);
+            GST_DEBUG ("target %s, default flags %08x", name, flags);
+          } else if (flags & (1U << i)) {
+            name = orc_target_get_flag_name (target, i);
+            GST_DEBUG ("target flag %s", name);
+          } else
+            name = NULL;
+
+          if (name) {
+#ifdef CHECK_X86
+            video_scaler_check_x86 (name);
+#endif
+          }
+        }
+      }
+    }
+#endif
+    g_once_init_leave (&init_gonce, 1);
+  }
+}
+
 static void
 resampler_zip (GstVideoResampler * resampler, const GstVideoResampler * r1,
     const GstVideoResampler * r2)
@@ -219,6 +279,8 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
   g_return_val_if_fail (in_size != 0, NULL);
   g_return_val_if_fail (out_size != 0, NULL);
 
+  video_scaler_init ();
+
   scale = g_new0 (GstVideoScaler, 1);
 
   GST_DEBUG ("%d %u  %u->%u", method, n_taps, in_size, out_size);
@@ -814,6 +876,8 @@ video_scale_h_ntap_u16 (GstVideoScaler * scale,
   if (max_taps == 2) {
     video_orc_resample_h_2tap_u16 (d, pixels, pixels + count, taps,
         taps + count, count);
+  } else if (resample_h_ntap_u16) {
+    resample_h_ntap_u16 (d, pixels, taps, max_taps, count);
   } else {
     /* first pixels with first tap to t4 */
     video_orc_resample_h_multaps_u16 (temp, pixels, taps, count);
@@ -1094,9 +1158,15 @@ video_scale_v_ntap_u16 (GstVideoScaler * scale,
   else
     src_inc = 1;
 
-  temp = (gint32 *) scale->tmpline2;
   count = width * n_elems;
 
+  if (resample_v_ntap_u16) {
+    resample_v_ntap_u16 (d, srcs, src_inc, taps, max_taps, count);
+    return;
+  }
+
+  temp = (gint32 *) scale->tmpline2;
+
   video_orc_resample_v_multaps_u16 (temp, srcs[0], taps[0], count);
   for (i = 1; i < max_taps; i++) {
     video_orc_resample_v_muladdtaps_u16 (temp, srcs[i * src_inc], taps[i],
@@ -190,27 +190,34 @@ fill_checker_##name##_c (GstVideoFrame * frame, guint y_start, guint y_end) \
   stride = GST_VIDEO_FRAME_COMP_STRIDE (frame, 0); \
   \
   dest += y_start * stride; \
-  if (!RGB) { \
-    for (i = y_start; i < y_end; i++) { \
+  for (i = y_start; i < y_end; i++) { \
+    guint8 *d = dest; \
+    \
+    /* the pattern only changes every 8 lines, copy an identical line \
+     * when one was already filled */ \
+    if (i > y_start && (i & 0x7) != 0) { \
+      memcpy (dest, dest - stride, width * 4); \
+    } else if (i >= y_start + 16) { \
+      memcpy (dest, dest - 16 * stride, width * 4); \
+    } else if (!RGB) { \
       for (j = 0; j < width; j++) { \
-        dest[A] = 0xff; \
-        dest[C1] = tab[((i & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
-        dest[C2] = 128; \
-        dest[C3] = 128; \
-        dest += 4; \
+        d[A] = 0xff; \
+        d[C1] = tab[((i & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
+        d[C2] = 128; \
+        d[C3] = 128; \
+        d += 4; \
       } \
-    } \
-  } else { \
-    for (i = y_start; i < y_end; i++) { \
+    } else { \
       for (j = 0; j < width; j++) { \
         val = tab[((i & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
-        dest[A] = 0xFF; \
-        dest[C1] = val; \
-        dest[C2] = val; \
-        dest[C3] = val; \
-        dest += 4; \
+        d[A] = 0xFF; \
+        d[C1] = val; \
+        d[C2] = val; \
+        d[C3] = val; \
+        d += 4; \
       } \
     } \
+    dest += stride; \
   } \
 }
 
@@ -420,10 +427,18 @@ fill_checker_##format_name (GstVideoFrame * frame, guint y_start, guint y_end) \
   p += comp_yoffset * rowstride; \
   \
   for (i = 0; i < comp_height; i++) { \
-    for (j = 0; j < comp_width; j++) { \
-      *p++ = tab[(((i + y_start) & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
+    /* the pattern only changes every 8 lines, copy an identical line \
+     * when one was already filled */ \
+    if (i > 0 && ((i + y_start) & 0x7) != 0) { \
+      memcpy (p, p - rowstride, comp_width); \
+    } else if (i >= 16) { \
+      memcpy (p, p - 16 * rowstride, comp_width); \
+    } else { \
+      for (j = 0; j < comp_width; j++) { \
+        p[j] = tab[(((i + y_start) & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
+      } \
     } \
-    p += rowstride - comp_width; \
+    p += rowstride; \
   } \
   \
   p = GST_VIDEO_FRAME_COMP_DATA (frame, 1); \
@@ -1537,10 +1552,18 @@ fill_checker_##format_name (GstVideoFrame * frame, guint y_start, guint y_end) \
   p += comp_yoffset * rowstride; \
   \
   for (i = 0; i < comp_height; i++) { \
-    for (j = 0; j < comp_width; j++) { \
-      *p++ = tab[(((i + y_start) & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
+    /* the pattern only changes every 8 lines, copy an identical line \
+     * when one was already filled */ \
+    if (i > 0 && ((i + y_start) & 0x7) != 0) { \
+      memcpy (p, p - rowstride, comp_width); \
+    } else if (i >= 16) { \
+      memcpy (p, p - 16 * rowstride, comp_width); \
+    } else { \
+      for (j = 0; j < comp_width; j++) { \
+        p[j] = tab[(((i + y_start) & 0x8) >> 3) + ((j & 0x8) >> 3)]; \
+      } \
     } \
-    p += rowstride - comp_width; \
+    p += rowstride; \
   } \
   \
   p = GST_VIDEO_FRAME_PLANE_DATA (frame, 1); \
@@ -459,19 +459,85 @@ clamp_rectangle (gint x, gint y, gint w, gint h, gint outer_width,
   return clamped;
 }
 
-/* Call this with the lock taken */
+/* The blend functions of subsampled formats move frames to the chroma grid,
+ * returns the part of the output a frame placed at @x,@y can touch */
+static GstVideoRectangle
+_get_drawn_rectangle (GstVideoAggregator * vagg, gint x, gint y, gint w,
+    gint h)
+{
+  const GstVideoFormatInfo *finfo = vagg->info.finfo;
+
+  w += GST_ROUND_UP_N (x, 1 << GST_VIDEO_FORMAT_INFO_W_SUB (finfo, 1)) - x;
+  h += GST_ROUND_UP_N (y, 1 << GST_VIDEO_FORMAT_INFO_H_SUB (finfo, 1)) - y;
+
+  return clamp_rectangle (x, y, w, h, GST_VIDEO_INFO_WIDTH (&vagg->info),
+      GST_VIDEO_INFO_HEIGHT (&vagg->info));
+}
+
+/* Test whether the union of @rects covers @rect (geometrically) */
 static gboolean
-_pad_obscures_rectangle (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad,
-    const GstVideoRectangle rect)
+is_rectangle_covered (const GstVideoRectangle rect,
+    const GstVideoRectangle * rects, guint n_rects)
+{
+  GstVideoRectangle part;
+  gint x1, y1, x2, y2;
+  guint i;
+
+  if (rect.w <= 0 || rect.h <= 0)
+    return TRUE;
+
+  for (i = 0; i < n_rects; i++) {
+    x1 = MAX (rect.x, rects[i].x);
+    y1 = MAX (rect.y, rects[i].y);
+    x2 = MIN (rect.x + rect.w, rects[i].x + rects[i].w);
+    y2 = MIN (rect.y + rect.h, rects[i].y + rects[i].h);
+
+    if (x1 >= x2 || y1 >= y2)
+      continue;
+
+    /* Split what is left of @rect into the parts above, below, left and right
+     * of the intersection and check those against the remaining rectangles */
+    part.x = rect.x;
+    part.y = rect.y;
+    part.w = rect.w;
+    part.h = y1 - rect.y;
+    if (!is_rectangle_covered (part, &rects[i + 1], n_rects - i - 1))
+      return FALSE;
+
+    part.y = y2;
+    part.h = rect.y + rect.h - y2;
+    if (!is_rectangle_covered (part, &rects[i + 1], n_rects - i - 1))
+      return FALSE;
+
+    part.y = y1;
+    part.w = x1 - rect.x;
+    part.h = y2 - y1;
+    if (!is_rectangle_covered (part, &rects[i + 1], n_rects - i - 1))
+      return FALSE;
+
+    part.x = x2;
+    part.w = rect.x + rect.w - x2;
+    return is_rectangle_covered (part, &rects[i + 1], n_rects - i - 1);
+  }
+
+  return FALSE;
+}
+
+/* Returns in @rect the area of the output that @pad is going to completely
+ * overwrite with opaque pixels, if any.
+ * Call this with the lock taken */
+static gboolean
+_pad_get_opaque_rectangle (GstVideoAggregator * vagg,
+    GstVideoAggregatorPad * pad, GstVideoRectangle * rect)
 {
-  GstVideoRectangle pad_rect;
   GstCompositorPad *cpad = GST_COMPOSITOR_PAD (pad);
+  const GstVideoFormatInfo *finfo = vagg->info.finfo;
   GstStructure *converter_config = NULL;
   gboolean fill_border = TRUE;
   guint32 border_argb = 0xff000000;
-  gint x_offset, y_offset;
+  gint x_offset, y_offset, x, y;
 
-  /* No buffer to obscure the rectangle with */
+  /* No buffer to obscure anything with */
   if (!gst_video_aggregator_pad_has_current_buffer (pad))
     return FALSE;
 
@@ -496,14 +562,38 @@ _pad_obscures_rectangle (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad,
   if (!fill_border || (border_argb & 0xff000000) != 0xff000000)
     return FALSE;
 
-  pad_rect.x = cpad->xpos;
-  pad_rect.y = cpad->ypos;
+  rect->x = cpad->xpos;
+  rect->y = cpad->ypos;
   /* Handle pixel and display aspect ratios to find the actual size */
   _mixer_pad_get_output_size (GST_COMPOSITOR (vagg), cpad,
       GST_VIDEO_INFO_PAR_N (&vagg->info), GST_VIDEO_INFO_PAR_D (&vagg->info),
-      &(pad_rect.w), &(pad_rect.h), &x_offset, &y_offset);
-  pad_rect.x += x_offset;
-  pad_rect.y += y_offset;
+      &(rect->w), &(rect->h), &x_offset, &y_offset);
+  rect->x += x_offset;
+  rect->y += y_offset;
+
+  /* The blend functions of subsampled formats round the position up to the
+   * chroma grid, only keep the part that is drawn in any case */
+  if (finfo) {
+    x = GST_ROUND_UP_N (rect->x, 1 << GST_VIDEO_FORMAT_INFO_W_SUB (finfo, 1));
+    y = GST_ROUND_UP_N (rect->y, 1 << GST_VIDEO_FORMAT_INFO_H_SUB (finfo, 1));
+    rect->w -= x - rect->x;
+    rect->h -= y - rect->y;
+    rect->x = x;
+    rect->y = y;
+  }
+
+  return rect->w > 0 && rect->h > 0;
+}
+
+/* Call this with the lock taken */
+static gboolean
+_pad_obscures_rectangle (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad,
+    const GstVideoRectangle rect)
+{
+  GstVideoRectangle pad_rect;
+
+  if (!_pad_get_opaque_rectangle (vagg, pad, &pad_rect))
+    return FALSE;
 
   if (!is_rectangle_contained (rect, pad_rect))
     return FALSE;
@@ -515,6 +605,37 @@ _pad_obscures_rectangle (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad,
   return TRUE;
 }
 
+/* Collects the opaque rectangles of the pads following @l in zorder that have
+ * a buffer, returns the number of rectangles stored in @rects.
+ * Call this with the lock taken */
+static guint
+_collect_opaque_rectangles (GstVideoAggregator * vagg, GList * l,
+    GstVideoRectangle * rects)
+{
+  guint n_rects = 0;
+
+  for (; l; l = l->next) {
+    GstBuffer *pad_buffer;
+
+    pad_buffer =
+        gst_video_aggregator_pad_get_current_buffer (GST_VIDEO_AGGREGATOR_PAD
+        (l->data));
+
+    if (pad_buffer == NULL)
+      continue;
+
+    if (gst_buffer_get_size (pad_buffer) == 0 &&
+        GST_BUFFER_FLAG_IS_SET (pad_buffer, GST_BUFFER_FLAG_GAP)) {
+      continue;
+    }
+
+    if (_pad_get_opaque_rectangle (vagg, l->data, &rects[n_rects]))
+      n_rects++;
+  }
+
+  return n_rects;
+}
+
 static void
 gst_compositor_pad_prepare_frame_start (GstVideoAggregatorPad * pad,
     GstVideoAggregator * vagg, GstBuffer * buffer,
@@ -552,9 +673,8 @@ gst_compositor_pad_prepare_frame_start (GstVideoAggregatorPad * pad,
   if (gst_aggregator_pad_is_inactive (GST_AGGREGATOR_PAD (pad)))
     return;
 
-  frame_rect = clamp_rectangle (cpad->xpos + cpad->x_offset,
-      cpad->ypos + cpad->y_offset, width, height,
-      GST_VIDEO_INFO_WIDTH (&vagg->info), GST_VIDEO_INFO_HEIGHT (&vagg->info));
+  frame_rect = _get_drawn_rectangle (vagg, cpad->xpos + cpad->x_offset,
+      cpad->ypos + cpad->y_offset, width, height);
 
   if (frame_rect.w == 0 || frame_rect.h == 0) {
     GST_DEBUG_OBJECT (pad, "Resulting frame is zero-width or zero-height "
@@ -563,37 +683,24 @@ gst_compositor_pad_prepare_frame_start (GstVideoAggregatorPad * pad,
   }
 
   GST_OBJECT_LOCK (vagg);
-  /* Check if this frame is obscured by a higher-zorder frame
-   * TODO: Also skip a frame if it's obscured by a combination of
-   * higher-zorder frames */
+  /* Check if this frame is obscured by the higher-zorder frames */
   l = g_list_find (GST_ELEMENT (vagg)->sinkpads, pad);
   /* The pad might've just been removed */
-  if (l)
-    l = l->next;
-  for (; l; l = l->next) {
-    GstBuffer *pad_buffer;
-
-    pad_buffer =
-        gst_video_aggregator_pad_get_current_buffer (GST_VIDEO_AGGREGATOR_PAD
-        (l->data));
-
-    if (pad_buffer == NULL)
-      continue;
-
-    if (gst_buffer_get_size (pad_buffer) == 0 &&
-        GST_BUFFER_FLAG_IS_SET (pad_buffer, GST_BUFFER_FLAG_GAP)) {
-      continue;
-    }
+  if (l) {
+    GstVideoRectangle *rects;
+    guint n_rects;
 
-    if (_pad_obscures_rectangle (vagg, l->data, frame_rect)) {
-      frame_obscured = TRUE;
-      break;
-    }
+    rects = g_newa (GstVideoRectangle, GST_ELEMENT (vagg)->numsinkpads);
+    n_rects = _collect_opaque_rectangles (vagg, l->next, rects);
+    frame_obscured = is_rectangle_covered (frame_rect, rects, n_rects);
   }
   GST_OBJECT_UNLOCK (vagg);
 
-  if (frame_obscured)
+  if (frame_obscured) {
+    GST_DEBUG_OBJECT (pad, "Obscured by higher-zorder pads, not converting "
+        "frame");
     return;
+  }
 
   GST_VIDEO_AGGREGATOR_PAD_CLASS
       (gst_compositor_pad_parent_class)->prepare_frame_start (pad, vagg, buffer,
@@ -820,6 +927,7 @@ set_functions (GstCompositor * self, const GstVideoInfo * info)
 
   gst_clear_buffer (&self->intermediate_frame);
   g_clear_pointer (&self->intermediate_convert, gst_video_converter_free);
+  gst_clear_object (&self->passthrough_pad);
 
   self->blend = NULL;
   self->overlay = NULL;
@@ -1488,38 +1596,121 @@ gst_composior_stop (GstAggregator * agg)
 
   gst_clear_buffer (&self->intermediate_frame);
   g_clear_pointer (&self->intermediate_convert, gst_video_converter_free);
+  gst_clear_object (&self->passthrough_pad);
 
   return GST_AGGREGATOR_CLASS (parent_class)->stop (agg);
 }
 
+/* Call this with the lock taken */
 static gboolean
-_should_draw_background (GstVideoAggregator * vagg)
+_pad_can_passthrough (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad)
 {
-  GstVideoRectangle bg_rect;
-  gboolean draw = TRUE;
-  GList *l;
+  GstVideoRectangle out_rect;
+  GstBuffer *buffer;
+  GstVideoMeta *meta;
+  gint width, height, x_offset, y_offset;
+  guint i;
 
-  bg_rect.x = bg_rect.y = 0;
+  /* The pad must not need any conversion nor scaling */
+  if (GST_VIDEO_INFO_FORMAT (&pad->info) != GST_VIDEO_INFO_FORMAT (&vagg->info)
+      || GST_VIDEO_INFO_WIDTH (&pad->info) != GST_VIDEO_INFO_WIDTH (&vagg->info)
+      || GST_VIDEO_INFO_HEIGHT (&pad->info) !=
+      GST_VIDEO_INFO_HEIGHT (&vagg->info))
+    return FALSE;
+
+  _mixer_pad_get_output_size (GST_COMPOSITOR (vagg), GST_COMPOSITOR_PAD (pad),
+      GST_VIDEO_INFO_PAR_N (&vagg->info), GST_VIDEO_INFO_PAR_D (&vagg->info),
+      &width, &height, &x_offset, &y_offset);
+  if (width != GST_VIDEO_INFO_WIDTH (&vagg->info) ||
+      height != GST_VIDEO_INFO_HEIGHT (&vagg->info))
+    return FALSE;
+
+  /* Being opaque and covering the whole output also means it's placed at 0,0 */
+  out_rect.x = out_rect.y = 0;
+  out_rect.w = GST_VIDEO_INFO_WIDTH (&vagg->info);
+  out_rect.h = GST_VIDEO_INFO_HEIGHT (&vagg->info);
+  if (!_pad_obscures_rectangle (vagg, pad, out_rect))
+    return FALSE;
+
+  buffer = gst_video_aggregator_pad_get_current_buffer (pad);
+  if (gst_buffer_get_size (buffer) < GST_VIDEO_INFO_SIZE (&vagg->info))
+    return FALSE;
+
+  /* The output buffer won't carry a video meta, so the memory layout has to
+   * be the default one */
+  meta = gst_buffer_get_video_meta (buffer);
+  if (meta) {
+    for (i = 0; i < meta->n_planes; i++) {
+      if (meta->offset[i] != GST_VIDEO_INFO_PLANE_OFFSET (&vagg->info, i) ||
+          meta->stride[i] != GST_VIDEO_INFO_PLANE_STRIDE (&vagg->info, i))
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/* Returns the pad whose current buffer is the whole output frame, if any.
+ * Call this with the lock taken */
+static GstVideoAggregatorPad *
+_find_passthrough_pad (GstVideoAggregator * vagg)
+{
+  GstVideoAggregatorPad *passthrough_pad = NULL;
+  GList *l;
 
-  GST_OBJECT_LOCK (vagg);
-  bg_rect.w = GST_VIDEO_INFO_WIDTH (&vagg->info);
-  bg_rect.h = GST_VIDEO_INFO_HEIGHT (&vagg->info);
-  /* Check if the background is completely obscured by a pad
-   * TODO: Also skip if it's obscured by a combination of pads */
   for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
-    if (gst_aggregator_pad_is_inactive (GST_AGGREGATOR_PAD (l->data))
-        ||
-        gst_video_aggregator_pad_get_prepared_frame (GST_VIDEO_AGGREGATOR_PAD
-            (l->data)) == NULL)
+    GstVideoAggregatorPad *pad = l->data;
+    GstBuffer *buffer;
+
+    if (gst_aggregator_pad_is_inactive (GST_AGGREGATOR_PAD (pad)) ||
+        GST_COMPOSITOR_PAD (pad)->alpha == 0.0)
       continue;
 
-    if (_pad_obscures_rectangle (vagg, l->data, bg_rect)) {
-      draw = FALSE;
-      break;
-    }
+    buffer = gst_video_aggregator_pad_get_current_buffer (pad);
+    if (buffer == NULL || (gst_buffer_get_size (buffer) == 0 &&
+            GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_GAP)))
+      continue;
+
+    /* Pads are sorted by zorder, any pad drawn on top of a candidate
+     * prevents passthrough */
+    passthrough_pad = _pad_can_passthrough (vagg, pad) ? pad : NULL;
+  }
+
+  return passthrough_pad;
+}
+
+static GstFlowReturn
+gst_compositor_create_output_buffer (GstVideoAggregator * vagg,
+    GstBuffer ** outbuf)
+{
+  GstCompositor *compositor = GST_COMPOSITOR (vagg);
+  GstBuffer *buffer = NULL;
+  GstVideoAggregatorPad *pad = NULL;
+
+  GST_OBJECT_LOCK (vagg);
+  if (!compositor->intermediate_frame)
+    pad = _find_passthrough_pad (vagg);
+
+  if (pad) {
+    /* Only share the memory, the input metas don't apply to the output.
+     * aggregate_frames() checks again that nothing has to be drawn once the
+     * pad properties are synchronized and the frames prepared */
+    buffer = gst_buffer_copy_region (gst_video_aggregator_pad_get_current_buffer
+        (pad), GST_BUFFER_COPY_MEMORY, 0, -1);
+    gst_object_replace ((GstObject **) & compositor->passthrough_pad,
+        GST_OBJECT (pad));
   }
   GST_OBJECT_UNLOCK (vagg);
-  return draw;
+
+  if (buffer) {
+    GST_LOG_OBJECT (pad, "Using input buffer memory as output");
+    *outbuf = buffer;
+    return GST_FLOW_OK;
+  }
+
+  return
+      GST_VIDEO_AGGREGATOR_CLASS (parent_class)->create_output_buffer (vagg,
+      outbuf);
 }
 
 static gboolean
@@ -1539,6 +1730,10 @@ struct CompositePadInfo
   GstVideoFrame *prepared_frame;
   GstCompositorPad *pad;
   GstCompositorBlendMode blend_mode;
+  /* part of the output the frame is drawn to */
+  GstVideoRectangle rect;
+  /* index of the first opaque rectangle of the higher-zorder pads */
+  guint opaque_rects_start;
 };
 
 struct CompositeTask
@@ -1550,6 +1745,9 @@ struct CompositeTask
   gboolean draw_background;
   guint n_pads;
   struct CompositePadInfo *pads_info;
+  /* opaque rectangles of all the pads, in zorder */
+  guint n_opaque_rects;
+  GstVideoRectangle *opaque_rects;
 };
 
 static void
@@ -1615,16 +1813,40 @@ static void
 blend_pads (struct CompositeTask *comp)
 {
   BlendFunction composite;
-  guint i;
+  GstVideoRectangle stripe_rect, rect;
+  guint i, start;
 
   composite = comp->compositor->blend;
 
+  stripe_rect.x = 0;
+  stripe_rect.y = comp->dst_line_start;
+  stripe_rect.w = GST_VIDEO_FRAME_WIDTH (comp->out_frame);
+  stripe_rect.h = comp->dst_line_end - comp->dst_line_start;
+
   if (comp->draw_background) {
-    _draw_background (comp->compositor, comp->out_frame, comp->dst_line_start,
-        comp->dst_line_end, &composite);
+    /* The opaque pads might still cover all of this stripe */
+    if (!is_rectangle_covered (stripe_rect, comp->opaque_rects,
+            comp->n_opaque_rects)) {
+      _draw_background (comp->compositor, comp->out_frame,
+          comp->dst_line_start, comp->dst_line_end, &composite);
+    } else if (comp->compositor->background ==
+        COMPOSITOR_BACKGROUND_TRANSPARENT) {
+      composite = comp->compositor->overlay;
+    }
   }
 
   for (i = 0; i < comp->n_pads; i++) {
+    /* Skip pads that are hidden by higher-zorder opaque pads in this
+     * stripe */
+    rect = comp->pads_info[i].rect;
+    rect.y = MAX (rect.y, stripe_rect.y);
+    rect.h = MIN (comp->pads_info[i].rect.y + comp->pads_info[i].rect.h,
+        stripe_rect.y + stripe_rect.h) - rect.y;
+    start = comp->pads_info[i].opaque_rects_start;
+    if (is_rectangle_covered (rect, &comp->opaque_rects[start],
+            comp->n_opaque_rects - start))
+      continue;
+
     composite (comp->pads_info[i].prepared_frame,
         comp->pads_info[i].pad->xpos + comp->pads_info[i].pad->x_offset,
         comp->pads_info[i].pad->ypos + comp->pads_info[i].pad->y_offset,
@@ -1640,9 +1862,31 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
   GList *l;
   GstVideoFrame out_frame, intermediate_frame, *outframe;
   gboolean draw_background;
-  guint drawn_a_pad = FALSE;
   struct CompositePadInfo *pads_info;
-  guint i, n_pads = 0;
+  GstVideoRectangle bg_rect, *opaque_rects;
+  guint i, n_pads = 0, n_opaque_rects = 0;
+
+  if (compositor->passthrough_pad) {
+    GstVideoAggregatorPad *pad = compositor->passthrough_pad;
+    GstVideoFrame *prepared_frame;
+    gboolean passthrough;
+
+    GST_OBJECT_LOCK (vagg);
+    prepared_frame = gst_video_aggregator_pad_get_prepared_frame (pad);
+    passthrough = _find_passthrough_pad (vagg) == pad && prepared_frame &&
+        prepared_frame->buffer ==
+        gst_video_aggregator_pad_get_current_buffer (pad);
+    GST_OBJECT_UNLOCK (vagg);
+
+    gst_clear_object (&compositor->passthrough_pad);
+
+    if (passthrough)
+      return GST_FLOW_OK;
+
+    /* Mapping the output buffer for writing below gives us a private copy of
+     * the shared memory */
+    GST_DEBUG_OBJECT (vagg, "Can't passthrough input buffer anymore");
+  }
 
   if (!gst_video_frame_map (&out_frame, &vagg->info, outbuf, GST_MAP_WRITE)) {
     GST_WARNING_OBJECT (vagg, "Could not map output buffer");
@@ -1663,12 +1907,6 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
     outframe = &intermediate_frame;
   }
 
-  /* If one of the frames to be composited completely obscures the background,
-   * don't bother drawing the background at all. We can also always use the
-   * 'blend' BlendFunction in that case because it only changes if we have to
-   * overlay on top of a transparent background. */
-  draw_background = _should_draw_background (vagg);
-
   GST_OBJECT_LOCK (vagg);
   for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
     GstVideoAggregatorPad *pad = l->data;
@@ -1679,12 +1917,8 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
       n_pads++;
   }
 
-  /* If no prepared frame, we should draw background unconditionally in order
-   * to clear output buffer */
-  if (n_pads == 0)
-    draw_background = TRUE;
-
   pads_info = g_newa (struct CompositePadInfo, n_pads);
+  opaque_rects = g_newa (GstVideoRectangle, n_pads);
   n_pads = 0;
 
   for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
@@ -1710,25 +1944,47 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
     }
 
     if (prepared_frame != NULL) {
-      /* If this is the first pad we're drawing, and we didn't draw the
-       * background, and @prepared_frame has the same format, height, and width
-       * as @outframe, then we can just copy it as-is. Subsequent pads (if any)
-       * will be composited on top of it. */
-      if (!drawn_a_pad && !draw_background &&
-          frames_can_copy (prepared_frame, outframe)) {
-        gst_video_frame_copy (outframe, prepared_frame);
-      } else {
-        pads_info[n_pads].pad = compo_pad;
-        pads_info[n_pads].prepared_frame = prepared_frame;
-        pads_info[n_pads].blend_mode = blend_mode;
-        n_pads++;
-      }
-      drawn_a_pad = TRUE;
+      if (!gst_aggregator_pad_is_inactive (GST_AGGREGATOR_PAD (pad)) &&
+          _pad_get_opaque_rectangle (vagg, pad, &opaque_rects[n_opaque_rects]))
+        n_opaque_rects++;
+
+      pads_info[n_pads].pad = compo_pad;
+      pads_info[n_pads].prepared_frame = prepared_frame;
+      pads_info[n_pads].blend_mode = blend_mode;
+      pads_info[n_pads].rect = _get_drawn_rectangle (vagg,
+          compo_pad->xpos + compo_pad->x_offset,
+          compo_pad->ypos + compo_pad->y_offset,
+          GST_VIDEO_FRAME_WIDTH (prepared_frame),
+          GST_VIDEO_FRAME_HEIGHT (prepared_frame));
+      pads_info[n_pads].opaque_rects_start = n_opaque_rects;
+      n_pads++;
     }
   }
 
+  /* If the frames to be composited completely obscure the background, don't
+   * bother drawing the background at all. We can also always use the 'blend'
+   * BlendFunction in that case because it only changes if we have to overlay
+   * on top of a transparent background.
+   * If no prepared frame, we should draw background unconditionally in order
+   * to clear output buffer */
+  bg_rect.x = bg_rect.y = 0;
+  bg_rect.w = GST_VIDEO_INFO_WIDTH (&vagg->info);
+  bg_rect.h = GST_VIDEO_INFO_HEIGHT (&vagg->info);
+  draw_background = n_pads == 0 ||
+      !is_rectangle_covered (bg_rect, opaque_rects, n_opaque_rects);
+
+  /* If we don't draw the background and the first pad has the same format,
+   * height, and width as @outframe, then we can just copy it as-is.
+   * Subsequent pads (if any) will be composited on top of it. */
+  if (!draw_background && n_pads > 0 &&
+      frames_can_copy (pads_info[0].prepared_frame, outframe)) {
+    gst_video_frame_copy (outframe, pads_info[0].prepared_frame);
+    pads_info++;
+    n_pads--;
+  }
+
   {
-    guint n_threads, lines_per_thread;
+    guint n_threads, lines_per_thread, align;
     guint out_height;
     struct CompositeTask *tasks;
     struct CompositeTask **tasks_p;
@@ -1738,8 +1994,12 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
     tasks = g_newa (struct CompositeTask, n_threads);
     tasks_p = g_newa (struct CompositeTask *, n_threads);
 
+    /* Make each thread start on a line that has its own subsampled chroma
+     * line so that no two threads blend into the same chroma line */
+    align = 1 << GST_VIDEO_FORMAT_INFO_H_SUB (outframe->info.finfo, 1);
     out_height = GST_VIDEO_FRAME_HEIGHT (outframe);
     lines_per_thread = (out_height + n_threads - 1) / n_threads;
+    lines_per_thread = GST_ROUND_UP_N (lines_per_thread, align);
 
     for (i = 0; i < n_threads; i++) {
       tasks[i].compositor = compositor;
@@ -1747,11 +2007,13 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
       tasks[i].pads_info = pads_info;
       tasks[i].out_frame = outframe;
       tasks[i].draw_background = draw_background;
+      tasks[i].n_opaque_rects = n_opaque_rects;
+      tasks[i].opaque_rects = opaque_rects;
       /* This is a dumb split of the work by number of output lines.
        * If there is a section of the output that reads from a lot of source
        * pads, then that thread will consume more time. Maybe tracking and
        * splitting on the source fill rate would produce better results. */
-      tasks[i].dst_line_start = i * lines_per_thread;
+      tasks[i].dst_line_start = MIN (i * lines_per_thread, out_height);
       tasks[i].dst_line_end = MIN ((i + 1) * lines_per_thread, out_height);
 
       tasks_p[i] = &tasks[i];
@@ -1966,6 +2228,8 @@ gst_compositor_class_init (GstCompositorClass * klass)
   agg_class->negotiated_src_caps = _negotiated_caps;
   agg_class->stop = GST_DEBUG_FUNCPTR (gst_composior_stop);
   videoaggregator_class->aggregate_frames = gst_compositor_aggregate_frames;
+  videoaggregator_class->create_output_buffer =
+      gst_compositor_create_output_buffer;
 
   g_object_class_install_property (gobject_class, PROP_BACKGROUND,
       g_param_spec_enum ("background", "Background", "Background type",
@@ -154,6 +154,10 @@ struct _GstCompositor
   GstVideoConverter *intermediate_convert;
 
   GstParallelizedTaskRunner *blend_runner;
+
+  /* Pad whose input buffer memory is used as output buffer for the current
+   * frame, see gst_compositor_create_output_buffer() */
+  GstVideoAggregatorPad *passthrough_pad;
 };
 
 /**
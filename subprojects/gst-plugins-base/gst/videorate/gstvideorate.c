@@ -24,8 +24,13 @@
  * This element takes an incoming stream of timestamped video frames.
  * It will produce a perfect stream that matches the source pad's framerate.
  *
- * The correction is performed by dropping and duplicating frames, no fancy
- * algorithm is used to interpolate frames (yet).
+ * By default the correction is performed by dropping and duplicating frames.
+ * When the #GstVideoRate:interpolation property is set, frames falling
+ * between two input frames are generated from both of them instead, either by
+ * blending them or by blending blocks displaced along the motion estimated
+ * between them. This is only done for raw video in system memory with a
+ * fixed output framerate during forward playback and for input frames close
+ * to each other, in all other cases frames are dropped and duplicated.
  *
  * By default the element will simply negotiate the same framerate on its
  * source and sink pad.
@@ -102,6 +107,8 @@ enum
 #define DEFAULT_MAX_DUPLICATION_TIME      0
 #define DEFAULT_MAX_CLOSING_SEGMENT_DUPLICATION_DURATION   GST_SECOND
 #define DEFAULT_DROP_OUT_OF_SEGMENT       FALSE
+#define DEFAULT_INTERPOLATION   GST_VIDEO_RATE_INTERPOLATION_NONE
+#define DEFAULT_MAX_THREADS     0
 
 enum
 {
@@ -119,9 +126,49 @@ enum
   PROP_RATE,
   PROP_MAX_DUPLICATION_TIME,
   PROP_MAX_CLOSING_SEGMENT_DUPLICATION_DURATION,
-  PROP_DROP_OUT_OF_SEGMENT
+  PROP_DROP_OUT_OF_SEGMENT,
+  PROP_INTERPOLATION,
+  PROP_MAX_THREADS
 };
 
+#define GST_TYPE_VIDEO_RATE_INTERPOLATION (gst_video_rate_interpolation_get_type())
+static GType
+gst_video_rate_interpolation_get_type (void)
+{
+  static GType video_rate_interpolation_type = 0;
+
+  static const GEnumValue video_rate_interpolation[] = {
+    {GST_VIDEO_RATE_INTERPOLATION_NONE, "Drop and duplicate frames", "none"},
+    {GST_VIDEO_RATE_INTERPOLATION_BLEND, "Blend neighbouring frames",
+        "blend"},
+    {GST_VIDEO_RATE_INTERPOLATION_MOTION_COMPENSATED,
+        "Blend neighbouring frames along the estimated motion",
+        "motion-compensated"},
+    {0, NULL, NULL},
+  };
+
+  if (!video_rate_interpolation_type) {
+    video_rate_interpolation_type =
+        g_enum_register_static ("GstVideoRateInterpolation",
+        video_rate_interpolation);
+  }
+  return video_rate_interpolation_type;
+}
+
+/* Interpolated frames are processed in blocks of BLOCK_SIZE x BLOCK_SIZE
+ * pixels, which is a multiple of all chroma subsamplings. Motion vectors are
+ * searched with a three step search starting at SEARCH_STEP pixels, reaching
+ * up to 2 * SEARCH_STEP - 1 pixels in each direction. A match with a mean
+ * absolute luma difference above MAX_MEAN_SAD (in 8 bits) is not trusted and
+ * the block is blended in place instead. */
+#define BLOCK_SIZE 16
+#define SEARCH_STEP 4
+#define MAX_MEAN_SAD 16
+
+/* Only input frames at most MAX_INTERPOLATION_DISTANCE output frame durations
+ * apart are interpolated, frames in larger gaps are duplicated */
+#define MAX_INTERPOLATION_DISTANCE 4
+
 static GstStaticPadTemplate gst_video_rate_src_template =
     GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
@@ -333,6 +380,39 @@ gst_video_rate_class_init (GstVideoRateClass * klass)
           DEFAULT_DROP_OUT_OF_SEGMENT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstVideoRate:interpolation:
+   *
+   * How to generate output frames falling between two input frames. Only
+   * applies to raw video in system memory in formats with 8 bits samples or
+   * native endian 16 bits samples, with a fixed output framerate during
+   * forward playback. Frames are dropped and duplicated otherwise, and for
+   * input frames that are more than 4 output frames apart or marked as gaps.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (object_class, PROP_INTERPOLATION,
+      g_param_spec_enum ("interpolation", "Interpolation",
+          "How to generate frames between two input frames",
+          GST_TYPE_VIDEO_RATE_INTERPOLATION, DEFAULT_INTERPOLATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoRate:max-threads:
+   *
+   * Maximum number of threads used to interpolate frames (0 = auto)
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (object_class, PROP_MAX_THREADS,
+      g_param_spec_uint ("max-threads", "Max Threads",
+          "Maximum number of threads used to interpolate frames (0 = auto)",
+          0, G_MAXINT, DEFAULT_MAX_THREADS,
+          GST_PARAM_MUTABLE_READY | G_PARAM_READWRITE |
+          G_PARAM_STATIC_STRINGS));
+
+  gst_type_mark_as_plugin_api (GST_TYPE_VIDEO_RATE_INTERPOLATION, 0);
+
   gst_element_class_set_static_metadata (element_class,
       "Video rate adjuster", "Filter/Effect/Video",
       "Drops/duplicates/adjusts timestamps on video frames to make a perfect stream",
@@ -583,6 +663,106 @@ gst_video_rate_fixate_caps (GstBaseTransform * trans,
   return gst_caps_fixate (othercaps);
 }
 
+/* Returns the size in bytes of the samples of @finfo if frames in this format
+ * can be interpolated sample by sample, 0 otherwise */
+static guint
+gst_video_rate_get_sample_size (const GstVideoFormatInfo * finfo)
+{
+  guint i, sample_size;
+
+  if (GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo) == 0 ||
+      GST_VIDEO_FORMAT_INFO_HAS_PALETTE (finfo) ||
+      GST_VIDEO_FORMAT_INFO_IS_TILED (finfo) ||
+      GST_VIDEO_FORMAT_INFO_IS_COMPLEX (finfo))
+    return 0;
+
+  sample_size = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0) > 8 ? 2 : 1;
+  if (sample_size == 2 && GST_VIDEO_FORMAT_INFO_IS_LE (finfo) !=
+      (G_BYTE_ORDER == G_LITTLE_ENDIAN))
+    return 0;
+
+  /* every sample needs a byte or a word of its own */
+  for (i = 0; i < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); i++) {
+    guint depth = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, i);
+    gint pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, i);
+
+    if (GST_VIDEO_FORMAT_INFO_SHIFT (finfo, i) != 0)
+      return 0;
+    if (sample_size == 1 ? depth != 8 : (depth <= 8 || depth > 16))
+      return 0;
+    if (pstride <= 0 || pstride % sample_size != 0 ||
+        GST_VIDEO_FORMAT_INFO_POFFSET (finfo, i) % sample_size != 0)
+      return 0;
+  }
+
+  return sample_size;
+}
+
+/* Motion is estimated on the luma and blocks are then copied plane by plane,
+ * which requires all samples of a plane to share the same subsampling */
+static gboolean
+gst_video_rate_can_compensate (const GstVideoFormatInfo * finfo)
+{
+  gint comp[GST_VIDEO_MAX_COMPONENTS];
+  guint p, i;
+
+  if (!GST_VIDEO_FORMAT_INFO_IS_YUV (finfo) &&
+      !GST_VIDEO_FORMAT_INFO_IS_GRAY (finfo))
+    return FALSE;
+
+  for (p = 0; p < GST_VIDEO_FORMAT_INFO_N_PLANES (finfo); p++) {
+    gst_video_format_info_component (finfo, p, comp);
+
+    for (i = 1; i < GST_VIDEO_MAX_COMPONENTS && comp[i] >= 0; i++) {
+      if (GST_VIDEO_FORMAT_INFO_W_SUB (finfo, comp[i]) !=
+          GST_VIDEO_FORMAT_INFO_W_SUB (finfo, comp[0]) ||
+          GST_VIDEO_FORMAT_INFO_H_SUB (finfo, comp[i]) !=
+          GST_VIDEO_FORMAT_INFO_H_SUB (finfo, comp[0]) ||
+          GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, comp[i]) !=
+          GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, comp[0]))
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static void
+gst_video_rate_clear_interpolate_pool (GstVideoRate * videorate)
+{
+  if (videorate->interpolate_pool) {
+    gst_buffer_pool_set_active (videorate->interpolate_pool, FALSE);
+    gst_clear_object (&videorate->interpolate_pool);
+  }
+}
+
+static void
+gst_video_rate_setup_interpolation (GstVideoRate * videorate, GstCaps * caps)
+{
+  GstCapsFeatures *features;
+
+  gst_video_rate_clear_interpolate_pool (videorate);
+  videorate->can_interpolate = FALSE;
+  videorate->can_compensate = FALSE;
+
+  features = gst_caps_get_features (caps, 0);
+  if (!gst_structure_has_name (gst_caps_get_structure (caps, 0), "video/x-raw")
+      || (features && !gst_caps_features_is_equal (features,
+              GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY)))
+    return;
+
+  if (!gst_video_info_from_caps (&videorate->info, caps) ||
+      GST_VIDEO_INFO_IS_INTERLACED (&videorate->info) ||
+      gst_video_rate_get_sample_size (videorate->info.finfo) == 0) {
+    GST_DEBUG_OBJECT (videorate, "can't interpolate %" GST_PTR_FORMAT, caps);
+    return;
+  }
+
+  videorate->can_interpolate = TRUE;
+  videorate->can_compensate =
+      gst_video_rate_can_compensate (videorate->info.finfo);
+}
+
 static gboolean
 gst_video_rate_setcaps (GstBaseTransform * trans, GstCaps * in_caps,
     GstCaps * out_caps)
@@ -631,6 +811,7 @@ gst_video_rate_setcaps (GstBaseTransform * trans, GstCaps * in_caps,
 done:
   if (ret) {
     gst_caps_replace (&videorate->in_caps, in_caps);
+    gst_video_rate_setup_interpolation (videorate, in_caps);
   }
 
   return ret;
@@ -684,6 +865,8 @@ gst_video_rate_init (GstVideoRate * videorate)
   videorate->max_duplication_time = DEFAULT_MAX_DUPLICATION_TIME;
   videorate->max_closing_segment_duplication_duration =
       DEFAULT_MAX_CLOSING_SEGMENT_DUPLICATION_DURATION;
+  videorate->interpolation = DEFAULT_INTERPOLATION;
+  videorate->max_threads = DEFAULT_MAX_THREADS;
 
   videorate->from_rate_numerator = 0;
   videorate->from_rate_denominator = 0;
@@ -1430,6 +1613,426 @@ gst_video_rate_propose_allocation (GstBaseTransform * trans,
   return res;
 }
 
+struct _GstVideoRateInterpolateTask
+{
+  const GstVideoFrame *prev;
+  const GstVideoFrame *next;
+  GstVideoFrame *out;
+  guint weight;                 /* weight of the next frame, out of 256 */
+  guint sample_size;
+  gboolean compensate;
+  guint max_sad;                /* per pixel, at the luma depth */
+  gint start, end;              /* lines of the output frame to produce */
+};
+
+static void
+gst_video_rate_blend_samples (guint8 * out, const guint8 * prev,
+    const guint8 * next, gint n_bytes, guint weight, guint sample_size)
+{
+  guint iweight = 256 - weight;
+  gint i;
+
+  if (sample_size == 2) {
+    guint16 *o = (guint16 *) out;
+    const guint16 *p = (const guint16 *) prev;
+    const guint16 *n = (const guint16 *) next;
+
+    for (i = 0; i < n_bytes / 2; i++)
+      o[i] = (p[i] * iweight + n[i] * weight + 128) >> 8;
+  } else {
+    for (i = 0; i < n_bytes; i++)
+      out[i] = (prev[i] * iweight + next[i] * weight + 128) >> 8;
+  }
+}
+
+/* blends @n_bytes x @n_lines of @plane, read at (@prev_x, @prev_y) in the
+ * previous frame and at (@next_x, @next_y) in the next frame, into (@x, @y)
+ * of the output frame. Horizontal positions are in bytes. */
+static void
+gst_video_rate_blend_rect (const GstVideoRateInterpolateTask * task,
+    gint plane, gint x, gint y, gint prev_x, gint prev_y, gint next_x,
+    gint next_y, gint n_bytes, gint n_lines)
+{
+  gint prev_stride = GST_VIDEO_FRAME_PLANE_STRIDE (task->prev, plane);
+  gint next_stride = GST_VIDEO_FRAME_PLANE_STRIDE (task->next, plane);
+  gint out_stride = GST_VIDEO_FRAME_PLANE_STRIDE (task->out, plane);
+  const guint8 *p, *n;
+  guint8 *o;
+  gint i;
+
+  p = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (task->prev, plane) +
+      prev_y * prev_stride + prev_x;
+  n = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (task->next, plane) +
+      next_y * next_stride + next_x;
+  o = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (task->out, plane) +
+      y * out_stride + x;
+
+  for (i = 0; i < n_lines; i++) {
+    gst_video_rate_blend_samples (o, p, n, n_bytes, task->weight,
+        task->sample_size);
+    p += prev_stride;
+    n += next_stride;
+    o += out_stride;
+  }
+}
+
+/* number of bytes used by the pixels of a line of @plane */
+static gint
+gst_video_rate_get_line_size (const GstVideoFrame * frame, gint plane,
+    guint sample_size)
+{
+  gint comp[GST_VIDEO_MAX_COMPONENTS];
+  gint i, size = 0;
+
+  gst_video_format_info_component (frame->info.finfo, plane, comp);
+  for (i = 0; i < GST_VIDEO_MAX_COMPONENTS && comp[i] >= 0; i++) {
+    gint end = (GST_VIDEO_FRAME_COMP_WIDTH (frame, comp[i]) - 1) *
+        GST_VIDEO_FRAME_COMP_PSTRIDE (frame, comp[i]) +
+        GST_VIDEO_FRAME_COMP_POFFSET (frame, comp[i]) + sample_size;
+
+    size = MAX (size, end);
+  }
+
+  return size;
+}
+
+static void
+gst_video_rate_blend_lines (const GstVideoRateInterpolateTask * task)
+{
+  const GstVideoFormatInfo *finfo = task->out->info.finfo;
+  gint comp[GST_VIDEO_MAX_COMPONENTS];
+  guint p;
+
+  for (p = 0; p < GST_VIDEO_FRAME_N_PLANES (task->out); p++) {
+    gint h_sub, start, end;
+
+    gst_video_format_info_component (finfo, p, comp);
+    h_sub = GST_VIDEO_FORMAT_INFO_H_SUB (finfo, comp[0]);
+    start = GST_VIDEO_SUB_SCALE (h_sub, task->start);
+    end = GST_VIDEO_SUB_SCALE (h_sub, task->end);
+
+    gst_video_rate_blend_rect (task, p, 0, start, 0, start, 0, start,
+        gst_video_rate_get_line_size (task->out, p, task->sample_size),
+        end - start);
+  }
+}
+
+static guint
+gst_video_rate_block_sad (const GstVideoRateInterpolateTask * task,
+    gint prev_x, gint prev_y, gint next_x, gint next_y, gint width,
+    gint height)
+{
+  gint plane = GST_VIDEO_FRAME_COMP_PLANE (task->out, 0);
+  gint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (task->out, 0);
+  gint poffset = GST_VIDEO_FRAME_COMP_POFFSET (task->out, 0);
+  gint prev_stride = GST_VIDEO_FRAME_PLANE_STRIDE (task->prev, plane);
+  gint next_stride = GST_VIDEO_FRAME_PLANE_STRIDE (task->next, plane);
+  const guint8 *p, *n;
+  guint sad = 0;
+  gint i, j;
+
+  p = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (task->prev, plane) +
+      prev_y * prev_stride + prev_x * pstride + poffset;
+  n = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (task->next, plane) +
+      next_y * next_stride + next_x * pstride + poffset;
+
+  for (j = 0; j < height; j++) {
+    if (task->sample_size == 2) {
+      for (i = 0; i < width; i++)
+        sad += ABS (*(const guint16 *) (p + i * pstride) -
+            *(const guint16 *) (n + i * pstride));
+    } else {
+      for (i = 0; i < width; i++)
+        sad += ABS (p[i * pstride] - n[i * pstride]);
+    }
+    p += prev_stride;
+    n += next_stride;
+  }
+
+  return sad;
+}
+
+/* The output block at (@x, @y) lies on the motion vector (@vx, @vy), at the
+ * interpolated position between its origin in the previous frame and its
+ * destination in the next frame. Returns the offset of the origin from the
+ * output block. */
+static void
+gst_video_rate_get_block_origin (const GstVideoRateInterpolateTask * task,
+    gint vx, gint vy, gint * ox, gint * oy)
+{
+  *ox = vx * (gint) task->weight / 256;
+  *oy = vy * (gint) task->weight / 256;
+}
+
+static gboolean
+gst_video_rate_match_block (const GstVideoRateInterpolateTask * task,
+    gint x, gint y, gint width, gint height, gint vx, gint vy, guint * sad)
+{
+  gint frame_width = GST_VIDEO_FRAME_WIDTH (task->out);
+  gint frame_height = GST_VIDEO_FRAME_HEIGHT (task->out);
+  gint ox, oy;
+
+  gst_video_rate_get_block_origin (task, vx, vy, &ox, &oy);
+
+  /* both displaced blocks must be inside the frames */
+  if (x - ox < 0 || x - ox + width > frame_width ||
+      x + vx - ox < 0 || x + vx - ox + width > frame_width ||
+      y - oy < 0 || y - oy + height > frame_height ||
+      y + vy - oy < 0 || y + vy - oy + height > frame_height)
+    return FALSE;
+
+  *sad = gst_video_rate_block_sad (task, x - ox, y - oy, x + vx - ox,
+      y + vy - oy, width, height);
+
+  return TRUE;
+}
+
+/* three step search of the vector for which the displaced blocks of the
+ * previous and next frames are most similar */
+static void
+gst_video_rate_estimate_motion (const GstVideoRateInterpolateTask * task,
+    gint x, gint y, gint width, gint height, gint * vx, gint * vy)
+{
+  gint best_x = 0, best_y = 0, step;
+  guint best_sad, sad;
+
+  gst_video_rate_match_block (task, x, y, width, height, 0, 0, &best_sad);
+
+  for (step = SEARCH_STEP; step > 0 && best_sad > 0; step /= 2) {
+    gint cx = best_x, cy = best_y, i, j;
+
+    for (j = -1; j <= 1; j++) {
+      for (i = -1; i <= 1; i++) {
+        if (i == 0 && j == 0)
+          continue;
+
+        if (gst_video_rate_match_block (task, x, y, width, height,
+                cx + i * step, cy + j * step, &sad) && sad < best_sad) {
+          best_sad = sad;
+          best_x = cx + i * step;
+          best_y = cy + j * step;
+        }
+      }
+    }
+  }
+
+  if (best_sad > task->max_sad * width * height) {
+    best_x = 0;
+    best_y = 0;
+  }
+
+  *vx = best_x;
+  *vy = best_y;
+}
+
+static void
+gst_video_rate_compensate_blocks (const GstVideoRateInterpolateTask * task)
+{
+  const GstVideoFormatInfo *finfo = task->out->info.finfo;
+  gint frame_width = GST_VIDEO_FRAME_WIDTH (task->out);
+  gint comp[GST_VIDEO_MAX_COMPONENTS];
+  gint x, y;
+
+  for (y = task->start; y < task->end; y += BLOCK_SIZE) {
+    gint height = MIN (BLOCK_SIZE, task->end - y);
+
+    for (x = 0; x < frame_width; x += BLOCK_SIZE) {
+      gint width = MIN (BLOCK_SIZE, frame_width - x);
+      gint vx, vy, ox, oy;
+      guint p;
+
+      gst_video_rate_estimate_motion (task, x, y, width, height, &vx, &vy);
+      gst_video_rate_get_block_origin (task, vx, vy, &ox, &oy);
+
+      for (p = 0; p < GST_VIDEO_FRAME_N_PLANES (task->out); p++) {
+        gint w_sub, h_sub, pstride, comp_width, comp_height;
+        gint px, py, pw, ph, prev_x, prev_y, next_x, next_y;
+
+        gst_video_format_info_component (finfo, p, comp);
+        w_sub = GST_VIDEO_FORMAT_INFO_W_SUB (finfo, comp[0]);
+        h_sub = GST_VIDEO_FORMAT_INFO_H_SUB (finfo, comp[0]);
+        pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (task->out, comp[0]);
+        comp_width = GST_VIDEO_FRAME_COMP_WIDTH (task->out, comp[0]);
+        comp_height = GST_VIDEO_FRAME_COMP_HEIGHT (task->out, comp[0]);
+
+        px = x >> w_sub;
+        py = y >> h_sub;
+        pw = GST_VIDEO_SUB_SCALE (w_sub, x + width) - px;
+        ph = GST_VIDEO_SUB_SCALE (h_sub, y + height) - py;
+
+        prev_x = CLAMP ((x - ox) >> w_sub, 0, comp_width - pw);
+        prev_y = CLAMP ((y - oy) >> h_sub, 0, comp_height - ph);
+        next_x = CLAMP ((x + vx - ox) >> w_sub, 0, comp_width - pw);
+        next_y = CLAMP ((y + vy - oy) >> h_sub, 0, comp_height - ph);
+
+        gst_video_rate_blend_rect (task, p, px * pstride, py,
+            prev_x * pstride, prev_y, next_x * pstride, next_y,
+            pw * pstride, ph);
+      }
+    }
+  }
+}
+
+static void
+gst_video_rate_interpolate_lines (gpointer user_data)
+{
+  GstVideoRateInterpolateTask *task = user_data;
+
+  if (task->compensate)
+    gst_video_rate_compensate_blocks (task);
+  else
+    gst_video_rate_blend_lines (task);
+}
+
+/* Splits @out in stripes of block lines and interpolates them in parallel */
+static void
+gst_video_rate_interpolate_frame (GstVideoRate * videorate,
+    const GstVideoFrame * prev, const GstVideoFrame * next,
+    GstVideoFrame * out, guint weight)
+{
+  GstVideoRateInterpolateTask *tasks;
+  gpointer *ids;
+  gint height = GST_VIDEO_FRAME_HEIGHT (out);
+  guint n_threads, n_blocks, blocks_per_thread, i;
+  guint sample_size, luma_depth;
+
+  n_threads = videorate->max_threads;
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  if (n_threads > 1 && !videorate->task_pool) {
+    videorate->task_pool = gst_shared_task_pool_new ();
+    gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL
+        (videorate->task_pool), n_threads);
+    gst_task_pool_prepare (videorate->task_pool, NULL);
+  }
+
+  /* max-threads can only change in READY, this only allocates for the first
+   * frame */
+  if (videorate->n_tasks < n_threads) {
+    g_free (videorate->tasks);
+    g_free (videorate->task_ids);
+    videorate->tasks = g_new (GstVideoRateInterpolateTask, n_threads);
+    videorate->task_ids = g_new (gpointer, n_threads);
+    videorate->n_tasks = n_threads;
+  }
+  tasks = videorate->tasks;
+  ids = videorate->task_ids;
+
+  n_blocks = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  n_threads = CLAMP (n_threads, 1, n_blocks);
+  blocks_per_thread = (n_blocks + n_threads - 1) / n_threads;
+
+  sample_size = gst_video_rate_get_sample_size (out->info.finfo);
+  luma_depth = GST_VIDEO_FRAME_COMP_DEPTH (out, 0);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].prev = prev;
+    tasks[i].next = next;
+    tasks[i].out = out;
+    tasks[i].weight = weight;
+    tasks[i].sample_size = sample_size;
+    tasks[i].compensate = videorate->can_compensate &&
+        videorate->interpolation ==
+        GST_VIDEO_RATE_INTERPOLATION_MOTION_COMPENSATED;
+    tasks[i].max_sad = MAX_MEAN_SAD << (MAX (luma_depth, 8) - 8);
+    tasks[i].start = MIN (i * blocks_per_thread * BLOCK_SIZE, height);
+    tasks[i].end = MIN ((i + 1) * blocks_per_thread * BLOCK_SIZE, height);
+  }
+
+  for (i = 1; i < n_threads; i++)
+    ids[i] = gst_task_pool_push (videorate->task_pool,
+        gst_video_rate_interpolate_lines, &tasks[i], NULL);
+
+  gst_video_rate_interpolate_lines (&tasks[0]);
+
+  for (i = 1; i < n_threads; i++) {
+    if (ids[i])
+      gst_task_pool_join (videorate->task_pool, ids[i]);
+    else
+      gst_video_rate_interpolate_lines (&tasks[i]);
+  }
+}
+
+/* Pushes a frame for @next_ts interpolated between ->prevbuf at @prev_ts and
+ * @buffer at @in_ts. @pushed is set to FALSE when the frames could not be
+ * interpolated, nothing was pushed then. */
+static GstFlowReturn
+gst_video_rate_push_interpolated (GstVideoRate * videorate, GstBuffer * buffer,
+    GstClockTime prev_ts, GstClockTime in_ts, GstClockTime next_ts,
+    gboolean * pushed)
+{
+  GstVideoFrame prev_frame, next_frame, out_frame;
+  GstBuffer *outbuf = NULL;
+  guint weight;
+
+  *pushed = FALSE;
+
+  if (!videorate->interpolate_pool) {
+    GstBufferPool *pool = gst_video_buffer_pool_new ();
+    GstStructure *config = gst_buffer_pool_get_config (pool);
+
+    gst_buffer_pool_config_set_params (config, videorate->in_caps,
+        videorate->info.size, 0, 0);
+    if (!gst_buffer_pool_set_config (pool, config) ||
+        !gst_buffer_pool_set_active (pool, TRUE)) {
+      GST_WARNING_OBJECT (videorate, "failed to set up buffer pool, "
+          "not interpolating");
+      gst_object_unref (pool);
+      videorate->can_interpolate = FALSE;
+      return GST_FLOW_OK;
+    }
+    videorate->interpolate_pool = pool;
+  }
+
+  if (gst_buffer_pool_acquire_buffer (videorate->interpolate_pool, &outbuf,
+          NULL) != GST_FLOW_OK)
+    return GST_FLOW_OK;
+
+  if (!gst_video_frame_map (&prev_frame, &videorate->info,
+          videorate->prevbuf, GST_MAP_READ))
+    goto map_failed;
+  if (!gst_video_frame_map (&next_frame, &videorate->info, buffer,
+          GST_MAP_READ)) {
+    gst_video_frame_unmap (&prev_frame);
+    goto map_failed;
+  }
+  if (!gst_video_frame_map (&out_frame, &videorate->info, outbuf,
+          GST_MAP_WRITE)) {
+    gst_video_frame_unmap (&next_frame);
+    gst_video_frame_unmap (&prev_frame);
+    goto map_failed;
+  }
+
+  weight = gst_util_uint64_scale_round (next_ts - prev_ts, 256,
+      in_ts - prev_ts);
+
+  GST_LOG_OBJECT (videorate, "interpolating frame at %" GST_TIME_FORMAT
+      " with weight %u/256 for the new buffer", GST_TIME_ARGS (next_ts),
+      weight);
+
+  gst_video_rate_interpolate_frame (videorate, &prev_frame, &next_frame,
+      &out_frame, weight);
+
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&next_frame);
+  gst_video_frame_unmap (&prev_frame);
+
+  gst_buffer_copy_into (outbuf, videorate->prevbuf, GST_BUFFER_COPY_FLAGS, 0,
+      -1);
+
+  *pushed = TRUE;
+
+  return gst_video_rate_push_buffer (videorate, outbuf, FALSE, in_ts, FALSE);
+
+map_failed:
+  {
+    GST_DEBUG_OBJECT (videorate, "failed to map frames, not interpolating");
+    gst_buffer_unref (outbuf);
+    return GST_FLOW_OK;
+  }
+}
+
 static GstFlowReturn
 gst_video_rate_trans_ip_max_avg (GstVideoRate * videorate, GstBuffer * buf)
 {
@@ -1807,8 +2410,9 @@ gst_video_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
     }
   } else {
     GstClockTime prev_ts;
-    gint count = 0;
+    gint count = 0, n_interpolated = 0;
     gint64 diff1 = 0, diff2 = 0;
+    gboolean interpolate, interpolated;
 
     prev_ts = videorate->prev_ts;
 
@@ -1837,10 +2441,24 @@ gst_video_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
             &count))
       goto done;
 
+    /* frames can only be interpolated at known output timestamps going
+     * forward, and only between two actual frames close to each other.
+     * Across gaps the output would otherwise be a slow cross-fade */
+    interpolate = videorate->interpolation != GST_VIDEO_RATE_INTERPOLATION_NONE
+        && videorate->can_interpolate && videorate->segment.rate > 0.0
+        && videorate->to_rate_numerator
+        && !GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_GAP)
+        && !GST_BUFFER_FLAG_IS_SET (videorate->prevbuf, GST_BUFFER_FLAG_GAP)
+        && in_ts - prev_ts <= gst_util_uint64_scale (MAX_INTERPOLATION_DISTANCE,
+        videorate->to_rate_denominator * GST_SECOND,
+        videorate->to_rate_numerator);
+
     /* got 2 buffers, see which one is the best */
     do {
       GstClockTime next_ts;
 
+      interpolated = FALSE;
+
       if (gst_video_rate_apply_pending_rate (videorate))
         goto done;
 
@@ -1916,6 +2534,22 @@ gst_video_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
             GST_TIME_ARGS (next_ts));
       }
 
+      /* output a frame interpolated from both when it is between them */
+      if (interpolate && next_ts > prev_ts && next_ts < in_ts) {
+        GstFlowReturn r;
+
+        r = gst_video_rate_push_interpolated (videorate, buffer, prev_ts,
+            in_ts, next_ts, &interpolated);
+        if (r != GST_FLOW_OK) {
+          res = r;
+          goto done;
+        }
+        if (interpolated) {
+          n_interpolated++;
+          continue;
+        }
+      }
+
       /* output first one when its the best */
       if (diff1 <= diff2) {
         GstFlowReturn r;
@@ -1932,7 +2566,7 @@ gst_video_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
       /* continue while the first one was the best, if they were equal avoid
        * going into an infinite loop */
     }
-    while (diff1 < diff2);
+    while (interpolated || diff1 < diff2);
 
     /* if we outputted the first buffer more then once, we have dups */
     if (count > 1) {
@@ -1940,8 +2574,9 @@ gst_video_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
       if (!videorate->silent)
         gst_video_rate_notify_duplicate (videorate);
     }
-    /* if we didn't output the first buffer, we have a drop */
-    else if (count == 0) {
+    /* if we didn't output nor interpolate from the first buffer, we have a
+     * drop */
+    else if (count == 0 && n_interpolated == 0) {
       videorate->drop++;
 
       if (!videorate->silent)
@@ -1992,7 +2627,21 @@ gst_video_rate_start (GstBaseTransform * trans)
 static gboolean
 gst_video_rate_stop (GstBaseTransform * trans)
 {
-  gst_video_rate_reset (GST_VIDEO_RATE (trans), FALSE);
+  GstVideoRate *videorate = GST_VIDEO_RATE (trans);
+
+  gst_video_rate_reset (videorate, FALSE);
+
+  gst_video_rate_clear_interpolate_pool (videorate);
+  videorate->can_interpolate = FALSE;
+  videorate->can_compensate = FALSE;
+  if (videorate->task_pool) {
+    gst_task_pool_cleanup (videorate->task_pool);
+    gst_clear_object (&videorate->task_pool);
+  }
+  g_clear_pointer (&videorate->tasks, g_free);
+  g_clear_pointer (&videorate->task_ids, g_free);
+  videorate->n_tasks = 0;
+
   return TRUE;
 }
 
@@ -2054,6 +2703,12 @@ gst_video_rate_set_property (GObject * object,
       videorate->drop_out_of_segment = g_value_get_boolean (value);
       break;
     }
+    case PROP_INTERPOLATION:
+      videorate->interpolation = g_value_get_enum (value);
+      break;
+    case PROP_MAX_THREADS:
+      videorate->max_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2123,6 +2778,12 @@ gst_video_rate_get_property (GObject * object,
     case PROP_DROP_OUT_OF_SEGMENT:
       g_value_set_boolean (value, videorate->drop_out_of_segment);
       break;
+    case PROP_INTERPOLATION:
+      g_value_set_enum (value, videorate->interpolation);
+      break;
+    case PROP_MAX_THREADS:
+      g_value_set_uint (value, videorate->max_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
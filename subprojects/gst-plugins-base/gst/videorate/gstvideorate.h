@@ -22,9 +22,33 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
 
 G_BEGIN_DECLS
 
+/**
+ * GstVideoRateInterpolation:
+ * @GST_VIDEO_RATE_INTERPOLATION_NONE: Drop and duplicate frames
+ * @GST_VIDEO_RATE_INTERPOLATION_BLEND: Blend the two frames surrounding
+ *   the output timestamp, weighted by their distance to it
+ * @GST_VIDEO_RATE_INTERPOLATION_MOTION_COMPENSATED: Estimate the motion
+ *   between the two surrounding frames by block matching on the luma plane
+ *   and blend the displaced blocks. Falls back to blending for formats
+ *   without a separate luma plane.
+ *
+ * How frames between two input frames are generated.
+ *
+ * Since: 1.26
+ */
+typedef enum
+{
+  GST_VIDEO_RATE_INTERPOLATION_NONE,
+  GST_VIDEO_RATE_INTERPOLATION_BLEND,
+  GST_VIDEO_RATE_INTERPOLATION_MOTION_COMPENSATED,
+} GstVideoRateInterpolation;
+
+typedef struct _GstVideoRateInterpolateTask GstVideoRateInterpolateTask;
+
 #define GST_TYPE_VIDEO_RATE (gst_video_rate_get_type())
 G_DECLARE_FINAL_TYPE (GstVideoRate, gst_video_rate, GST, VIDEO_RATE,
     GstBaseTransform)
@@ -82,6 +106,19 @@ struct _GstVideoRate
    * right after a CAPS, we can reset to those caps and close the segment with
    * it */
   GstCaps *prev_caps;
+
+  /* interpolation */
+  GstVideoRateInterpolation interpolation;
+  guint max_threads;
+  GstVideoInfo info;            /* info of `in_caps`, only valid when
+                                 * `can_interpolate` is set */
+  gboolean can_interpolate;
+  gboolean can_compensate;      /* block matching possible on `info` */
+  GstBufferPool *interpolate_pool;
+  GstTaskPool *task_pool;
+  GstVideoRateInterpolateTask *tasks;   /* one per thread */
+  gpointer *task_ids;
+  guint n_tasks;
 };
 
 GST_ELEMENT_REGISTER_DECLARE (videorate);
@@ -1858,6 +1858,72 @@ GST_START_TEST (test_obscured_skipped)
 
 GST_END_TEST;
 
+/* sink_0 is covered by the left and right halves of the output, the right half
+ * starting at @xpos2 */
+static void
+_test_obscured_by_two_pads (gint xpos2)
+{
+  GstElement *pipeline, *mix, *sink;
+  GstSample *sample;
+  GstPad *srcpad, *sinkpad;
+  gint i;
+
+  pipeline =
+      gst_parse_launch ("videotestsrc name=src0 num-buffers=5 ! "
+      "video/x-raw,format=I420,width=20,height=20 ! compositor name=mix ! "
+      "video/x-raw,width=20,height=20 ! appsink name=sink "
+      "videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=I420,width=10,height=20 ! mix. "
+      "videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=I420,width=10,height=20 ! mix.", NULL);
+  fail_unless (pipeline != NULL);
+
+  mix = gst_bin_get_by_name (GST_BIN (pipeline), "mix");
+  for (i = 0; i < 3; i++) {
+    gchar *name = g_strdup_printf ("sink_%d", i);
+
+    sinkpad = gst_element_get_static_pad (mix, name);
+    fail_unless (sinkpad != NULL);
+    if (i == 0) {
+      srcpad = gst_pad_get_peer (sinkpad);
+      gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER,
+          test_obscured_pad_probe_cb, NULL, NULL);
+      gst_object_unref (srcpad);
+    } else if (i == 2) {
+      g_object_set (sinkpad, "xpos", xpos2, NULL);
+    }
+    gst_object_unref (sinkpad);
+    g_free (name);
+  }
+  gst_object_unref (mix);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  do {
+    g_signal_emit_by_name (sink, "pull-sample", &sample);
+    if (sample)
+      gst_sample_unref (sample);
+  } while (sample != NULL);
+  gst_object_unref (sink);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_START_TEST (test_obscured_by_combination_skipped)
+{
+  buffer_mapped = FALSE;
+  _test_obscured_by_two_pads (10);
+  fail_unless (buffer_mapped == FALSE);
+
+  /* Leave a gap between the two halves */
+  buffer_mapped = FALSE;
+  _test_obscured_by_two_pads (12);
+  fail_unless (buffer_mapped == TRUE);
+}
+
+GST_END_TEST;
+
 static void
 _pipeline_eos (GstBus * bus, GstMessage * message, GstPipeline * bin)
 {
@@ -2323,6 +2389,67 @@ GST_START_TEST (test_gap_events)
 
 GST_END_TEST;
 
+GST_START_TEST (test_passthrough)
+{
+  GstBuffer *inbuf, *outbuf;
+  GstElement *comp = gst_element_factory_make ("compositor", NULL);
+  GstHarness *h = gst_harness_new_with_element (comp, "sink_%u", "src");
+  GstPad *sinkpad;
+  GstVideoInfo info;
+  GstMapInfo map;
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw, format=I420, width=64, height=48, framerate=25/1");
+  gst_harness_play (h);
+
+  fail_unless (gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 64,
+          48));
+  sinkpad = gst_element_get_static_pad (comp, "sink_0");
+
+  /* An opaque frame covering the whole output is pushed as is */
+  inbuf = gst_buffer_new_allocate (NULL, info.size, NULL);
+  gst_buffer_memset (inbuf, 0, 42, info.size);
+  GST_BUFFER_PTS (inbuf) = 0;
+  GST_BUFFER_DURATION (inbuf) = 40 * GST_MSECOND;
+  gst_harness_push (h, gst_buffer_ref (inbuf));
+
+  outbuf = gst_harness_pull (h);
+  fail_unless (outbuf != inbuf);
+  fail_unless (gst_buffer_peek_memory (outbuf, 0) ==
+      gst_buffer_peek_memory (inbuf, 0));
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuf), 0);
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+
+  /* With alpha the frame has to be blended over the background */
+  g_object_set (sinkpad, "alpha", 0.5, NULL);
+  inbuf = gst_buffer_new_allocate (NULL, info.size, NULL);
+  gst_buffer_memset (inbuf, 0, 42, info.size);
+  GST_BUFFER_PTS (inbuf) = 40 * GST_MSECOND;
+  GST_BUFFER_DURATION (inbuf) = 40 * GST_MSECOND;
+  gst_harness_push (h, gst_buffer_ref (inbuf));
+
+  outbuf = gst_harness_pull (h);
+  fail_unless (gst_buffer_peek_memory (outbuf, 0) !=
+      gst_buffer_peek_memory (inbuf, 0));
+  gst_buffer_map (outbuf, &map, GST_MAP_READ);
+  fail_if (map.data[0] == 42);
+  gst_buffer_unmap (outbuf, &map);
+  gst_buffer_unref (outbuf);
+
+  /* The shared memory was left untouched */
+  gst_buffer_map (inbuf, &map, GST_MAP_READ);
+  fail_unless_equals_int (map.data[0], 42);
+  gst_buffer_unmap (inbuf, &map);
+  gst_buffer_unref (inbuf);
+
+  gst_object_unref (sinkpad);
+  gst_harness_teardown (h);
+  gst_object_unref (comp);
+}
+
+GST_END_TEST;
+
 static GstBuffer *expected_selected_buffer = NULL;
 
 static void
@@ -2769,6 +2896,7 @@ compositor_suite (void)
   tcase_add_test (tc_chain, test_loop);
   tcase_add_test (tc_chain, test_segment_base_handling);
   tcase_add_test (tc_chain, test_obscured_skipped);
+  tcase_add_test (tc_chain, test_obscured_by_combination_skipped);
   tcase_add_test (tc_chain, test_repeat_after_eos_1pad);
   tcase_add_test (tc_chain, test_repeat_after_eos_2pads_repeating_first);
   tcase_add_test (tc_chain, test_repeat_after_eos_2pads_repeating_last);
@@ -2785,6 +2913,7 @@ compositor_suite (void)
   tcase_add_test (tc_chain, test_start_time_first_live_drop_3);
   tcase_add_test (tc_chain, test_start_time_first_live_drop_3_unlinked_1);
   tcase_add_test (tc_chain, test_gap_events);
+  tcase_add_test (tc_chain, test_passthrough);
   tcase_add_test (tc_chain, test_signals);
   tcase_add_test (tc_chain, test_reverse);
   tcase_add_test (tc_chain, test_stream_start_after_eos);
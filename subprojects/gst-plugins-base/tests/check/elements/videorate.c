@@ -89,6 +89,13 @@ GST_STATIC_PAD_TEMPLATE ("sink",
     GST_STATIC_CAPS (VIDEO_CAPS_FORCE_VARIABLE_FRAMERATE_STRING)
     );
 
+static GstStaticPadTemplate framerate_50_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/x-raw, framerate = (fraction) 50/1")
+    );
+
 static void
 assert_videorate_stats (GstElement * videorate, const gchar * reason,
     guint64 xin, guint64 xout, guint64 xdropped, guint64 xduplicated)
@@ -2068,6 +2075,143 @@ GST_START_TEST (test_segment_update_average_period)
 
 GST_END_TEST;
 
+#define STRIPE_WIDTH 64
+#define STRIPE_HEIGHT 32
+
+/* GRAY8 frame with a white stripe over the columns [@x, @x + 16) */
+static GstBuffer *
+create_stripe_frame (gint x, GstClockTime pts)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  gint i;
+
+  buf = gst_buffer_new_and_alloc (STRIPE_WIDTH * STRIPE_HEIGHT);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (i = 0; i < STRIPE_WIDTH * STRIPE_HEIGHT; i++)
+    map.data[i] = (i % STRIPE_WIDTH >= x && i % STRIPE_WIDTH < x + 16) ?
+        255 : 0;
+  gst_buffer_unmap (buf, &map);
+  GST_BUFFER_PTS (buf) = pts;
+
+  return buf;
+}
+
+/* halfway between a stripe at 16 and a stripe at 22, blending gives two
+ * half transparent stripes while compensating the motion gives a stripe at 19 */
+static guint8
+expected_interpolated_pixel (gboolean compensated, gint x)
+{
+  if (compensated)
+    return (x >= 19 && x < 35) ? 255 : 0;
+
+  if (x >= 22 && x < 32)
+    return 255;
+  if ((x >= 16 && x < 22) || (x >= 32 && x < 38))
+    return 128;
+  return 0;
+}
+
+static const gchar *interpolation_modes[] = { "blend", "motion-compensated" };
+
+GST_START_TEST (test_interpolation)
+{
+  GstElement *videorate;
+  GstBuffer *outbuf;
+  GstCaps *caps;
+  GstMapInfo map;
+  gint x, y;
+
+  videorate = setup_videorate_full (&srctemplate, &framerate_50_template);
+  gst_util_set_object_arg (G_OBJECT (videorate), "interpolation",
+      interpolation_modes[__i__]);
+  g_object_set (videorate, "max-threads", 2, NULL);
+  ASSERT_SET_STATE (videorate, GST_STATE_PLAYING, GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_caps_from_string ("video/x-raw, format = (string) GRAY8, "
+      "width = (int) 64, height = (int) 32, framerate = (fraction) 25/1");
+  gst_check_setup_events (mysrcpad, videorate, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  fail_unless (gst_pad_push (mysrcpad,
+          create_stripe_frame (16, 0)) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad,
+          create_stripe_frame (22, GST_SECOND / 25)) == GST_FLOW_OK);
+
+  /* the first frame followed by a frame interpolated from both */
+  fail_unless_equals_int (g_list_length (buffers), 2);
+  assert_videorate_stats (videorate, "interpolated", 2, 2, 0, 0);
+
+  outbuf = buffers->next->data;
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuf), GST_SECOND / 50);
+  fail_unless_equals_uint64 (GST_BUFFER_DURATION (outbuf), GST_SECOND / 50);
+  fail_if (GST_BUFFER_FLAG_IS_SET (outbuf, GST_BUFFER_FLAG_GAP));
+
+  gst_buffer_map (outbuf, &map, GST_MAP_READ);
+  fail_unless_equals_int (map.size, STRIPE_WIDTH * STRIPE_HEIGHT);
+  for (y = 0; y < STRIPE_HEIGHT; y++) {
+    for (x = 0; x < STRIPE_WIDTH; x++) {
+      fail_unless_equals_int (map.data[y * STRIPE_WIDTH + x],
+          expected_interpolated_pixel (__i__ == 1, x));
+    }
+  }
+  gst_buffer_unmap (outbuf, &map);
+
+  cleanup_videorate (videorate);
+}
+
+GST_END_TEST;
+
+/* frames far apart or marked as gap are not interpolated, the output between
+ * them consists of duplicates */
+GST_START_TEST (test_interpolation_gap)
+{
+  GstElement *videorate;
+  GstBuffer *inbuf;
+  GstCaps *caps;
+  GList *l;
+  gint x, y;
+
+  videorate = setup_videorate_full (&srctemplate, &framerate_50_template);
+  gst_util_set_object_arg (G_OBJECT (videorate), "interpolation", "blend");
+  ASSERT_SET_STATE (videorate, GST_STATE_PLAYING, GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_caps_from_string ("video/x-raw, format = (string) GRAY8, "
+      "width = (int) 64, height = (int) 32, framerate = (fraction) 25/1");
+  gst_check_setup_events (mysrcpad, videorate, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  fail_unless (gst_pad_push (mysrcpad,
+          create_stripe_frame (16, 0)) == GST_FLOW_OK);
+  if (__i__ == 0) {
+    /* 10 output frames later */
+    inbuf = create_stripe_frame (22, GST_SECOND / 5);
+  } else {
+    inbuf = create_stripe_frame (22, GST_SECOND / 25);
+    GST_BUFFER_FLAG_SET (inbuf, GST_BUFFER_FLAG_GAP);
+  }
+  fail_unless (gst_pad_push (mysrcpad, inbuf) == GST_FLOW_OK);
+
+  fail_unless (g_list_length (buffers) >= 2);
+  for (l = buffers; l; l = l->next) {
+    GstBuffer *outbuf = l->data;
+    GstMapInfo map;
+
+    gst_buffer_map (outbuf, &map, GST_MAP_READ);
+    for (y = 0; y < STRIPE_HEIGHT; y++) {
+      for (x = 0; x < STRIPE_WIDTH; x++) {
+        fail_unless_equals_int (map.data[y * STRIPE_WIDTH + x],
+            (x >= 16 && x < 32) ? 255 : 0);
+      }
+    }
+    gst_buffer_unmap (outbuf, &map);
+  }
+
+  cleanup_videorate (videorate);
+}
+
+GST_END_TEST;
+
 static Suite *
 videorate_suite (void)
 {
@@ -2098,6 +2242,9 @@ videorate_suite (void)
   tcase_add_test (tc_chain, test_segment_update_start_advance);
   tcase_add_test (tc_chain, test_segment_update_same);
   tcase_add_test (tc_chain, test_segment_update_average_period);
+  tcase_add_loop_test (tc_chain, test_interpolation, 0,
+      G_N_ELEMENTS (interpolation_modes));
+  tcase_add_loop_test (tc_chain, test_interpolation_gap, 0, 2);
 
   return s;
 }
@@ -467,6 +467,204 @@ GST_END_TEST;
 #undef WIDTH
 #undef HEIGHT
 
+/* reference unpacking of pixel @i of the first line to AYUV64, following the
+ * format specifications, to check the vectorized unpack functions and the
+ * C code for the remaining pixels */
+static void
+unpack_reference_pixel (GstVideoFormat format, const GstVideoInfo * vinfo,
+    const guint8 * data, gint i, gboolean replicate, guint16 pixel[4])
+{
+  const guint8 *s = data + GST_VIDEO_INFO_PLANE_OFFSET (vinfo, 0);
+  const guint8 *suv = data + GST_VIDEO_INFO_PLANE_OFFSET (vinfo, 1);
+  guint bits = 10;
+  guint32 a, v[12];
+  guint16 A = 0xffff, Y, U, V;
+
+  switch (format) {
+    case GST_VIDEO_FORMAT_v210:
+      s += (i / 6) * 16;
+      for (a = 0; a < 4; a++) {
+        guint32 w = GST_READ_UINT32_LE (s + a * 4);
+
+        v[a * 3 + 0] = w & 0x3ff;
+        v[a * 3 + 1] = (w >> 10) & 0x3ff;
+        v[a * 3 + 2] = (w >> 20) & 0x3ff;
+      }
+      /* u0 y0 v0 y1 u2 y2 v2 y3 u4 y4 v4 y5 */
+      Y = v[(i % 6) * 2 + 1] << 6;
+      U = v[((i % 6) / 2) * 4] << 6;
+      V = v[((i % 6) / 2) * 4 + 2] << 6;
+      break;
+    case GST_VIDEO_FORMAT_Y210:
+      s += (i / 2) * 8;
+      Y = GST_READ_UINT16_LE (s + (i & 1) * 4);
+      U = GST_READ_UINT16_LE (s + 2);
+      V = GST_READ_UINT16_LE (s + 6);
+      break;
+    case GST_VIDEO_FORMAT_Y410:
+      a = GST_READ_UINT32_LE (s + i * 4);
+      U = (a & 0x3ff) << 6;
+      Y = ((a >> 10) & 0x3ff) << 6;
+      V = ((a >> 20) & 0x3ff) << 6;
+      A = ((a >> 30) & 0x3) << 14;
+      if (replicate)
+        A |= A >> 10;
+      break;
+    case GST_VIDEO_FORMAT_P012_LE:
+      bits = 12;
+      /* fall through */
+    case GST_VIDEO_FORMAT_P010_10LE:
+    case GST_VIDEO_FORMAT_P016_LE:
+      if (format == GST_VIDEO_FORMAT_P016_LE)
+        bits = 16;
+      Y = GST_READ_UINT16_LE (s + i * 2);
+      U = GST_READ_UINT16_LE (suv + (i & ~1) * 2);
+      V = GST_READ_UINT16_LE (suv + (i & ~1) * 2 + 2);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+
+  if (replicate && bits < 16) {
+    Y |= Y >> bits;
+    U |= U >> bits;
+    V |= V >> bits;
+  }
+
+  pixel[0] = A;
+  pixel[1] = Y;
+  pixel[2] = U;
+  pixel[3] = V;
+}
+
+/* These formats have vectorized pack and unpack functions for complete
+ * blocks of pixels, check that they give the same result as the reference
+ * and survive a round trip, with widths that leave various amounts of
+ * pixels for the C code */
+GST_START_TEST (test_video_formats_pack_unpack_high_depth)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_Y210, GST_VIDEO_FORMAT_Y410,
+    GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_P012_LE,
+    GST_VIDEO_FORMAT_P016_LE,
+  };
+  static const gint widths[] = { 1, 2, 5, 6, 7, 8, 9, 13, 23, 64, 65, 1919 };
+  GRand *rand = g_rand_new_with_seed (1);
+  guint f, w;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    const GstVideoFormatInfo *finfo = gst_video_format_get_info (formats[f]);
+
+    for (w = 0; w < G_N_ELEMENTS (widths); w++) {
+      gint width = widths[w];
+      GstVideoInfo vinfo;
+      gpointer data[GST_VIDEO_MAX_PLANES], packed[GST_VIDEO_MAX_PLANES];
+      gint stride[GST_VIDEO_MAX_PLANES];
+      guint8 *vdata, *pdata;
+      guint16 *unpacked, *repacked, pixel[4];
+      gsize j, size;
+      gint i;
+      guint p, replicate;
+
+      GST_INFO ("testing %s width %d", gst_video_format_to_string (formats[f]),
+          width);
+
+      gst_video_info_init (&vinfo);
+      fail_unless (gst_video_info_set_format (&vinfo, formats[f], width, 2));
+      size = GST_VIDEO_INFO_SIZE (&vinfo);
+      vdata = g_malloc0 (size);
+      pdata = g_malloc0 (size);
+
+      /* random samples, with the unused bits cleared */
+      for (j = 0; j + 4 <= size; j += 4) {
+        guint32 r = g_rand_int (rand);
+
+        switch (formats[f]) {
+          case GST_VIDEO_FORMAT_v210:
+            r &= 0x3fffffff;
+            break;
+          case GST_VIDEO_FORMAT_Y210:
+          case GST_VIDEO_FORMAT_P010_10LE:
+            r &= 0xffc0ffc0;
+            break;
+          case GST_VIDEO_FORMAT_P012_LE:
+            r &= 0xfff0fff0;
+            break;
+          default:
+            break;
+        }
+        GST_WRITE_UINT32_LE (vdata + j, r);
+      }
+
+      for (p = 0; p < GST_VIDEO_INFO_N_PLANES (&vinfo); p++) {
+        data[p] = vdata + GST_VIDEO_INFO_PLANE_OFFSET (&vinfo, p);
+        packed[p] = pdata + GST_VIDEO_INFO_PLANE_OFFSET (&vinfo, p);
+        stride[p] = GST_VIDEO_INFO_PLANE_STRIDE (&vinfo, p);
+      }
+
+      /* one more pixel to detect writes past the width */
+      unpacked = g_new (guint16, (width + 1) * 4);
+      repacked = g_new (guint16, (width + 1) * 4);
+
+      for (replicate = 0; replicate < 2; replicate++) {
+        GstVideoPackFlags flags = replicate ? GST_VIDEO_PACK_FLAG_NONE :
+            GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE;
+
+        memset (unpacked, 0x55, (width + 1) * 8);
+        finfo->unpack_func (finfo, flags, unpacked, data, stride, 0, 0,
+            width);
+
+        for (i = 0; i < width; i++) {
+          unpack_reference_pixel (formats[f], &vinfo, vdata, i, replicate,
+              pixel);
+          fail_unless (memcmp (&unpacked[i * 4], pixel, sizeof (pixel)) == 0,
+              "%s width %d pixel %d: got %04x %04x %04x %04x"
+              " expected %04x %04x %04x %04x",
+              gst_video_format_to_string (formats[f]), width, i,
+              unpacked[i * 4], unpacked[i * 4 + 1], unpacked[i * 4 + 2],
+              unpacked[i * 4 + 3], pixel[0], pixel[1], pixel[2], pixel[3]);
+        }
+        for (i = width * 4; i < (width + 1) * 4; i++)
+          fail_unless_equals_int (unpacked[i], 0x5555);
+
+        /* starting at an odd pixel, v210 has no horizontal offsets */
+        if (formats[f] == GST_VIDEO_FORMAT_v210 || width < 2)
+          continue;
+
+        finfo->unpack_func (finfo, flags, repacked, data, stride, 1, 0,
+            width - 1);
+        for (i = 1; i < width; i++) {
+          unpack_reference_pixel (formats[f], &vinfo, vdata, i, replicate,
+              pixel);
+          fail_unless (memcmp (&repacked[(i - 1) * 4], pixel,
+                  sizeof (pixel)) == 0, "%s width %d offset 1 pixel %d",
+              gst_video_format_to_string (formats[f]), width, i);
+        }
+      }
+
+      /* pack the last unpacked line, the chroma is the same for the pixels
+       * sharing it and the replicated bits are dropped, so unpacking again
+       * gives the same */
+      finfo->pack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, unpacked, 0, packed,
+          stride, GST_VIDEO_CHROMA_SITE_UNKNOWN, 0, width);
+      finfo->unpack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, repacked, packed,
+          stride, 0, 0, width);
+      fail_unless (memcmp (unpacked, repacked, width * 8) == 0,
+          "%s width %d round trip failed",
+          gst_video_format_to_string (formats[f]), width);
+
+      g_free (repacked);
+      g_free (unpacked);
+      g_free (pdata);
+      g_free (vdata);
+    }
+  }
+
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_formats)
 {
   guint i;
@@ -2477,6 +2675,121 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+#define SCALER_VALUE 0x8000
+
+static void
+check_scaled_line_u16 (const guint16 * line, gint n_values)
+{
+  gint i;
+
+  /* the integer taps are not always exact, allow one off */
+  for (i = 0; i < n_values; i++)
+    fail_unless (ABS (line[i] - SCALER_VALUE) <= 1, "value %d at %d",
+        line[i], i);
+}
+
+/* set to something larger to do benchmarks */
+#define TIME 0.01
+
+/* 16 bits formats with more than 2 taps go through the n-tap functions,
+ * which have SIMD versions. The sizes are chosen so that the lines don't
+ * end on a vector boundary. */
+GST_START_TEST (test_video_scaler_ntap_u16)
+{
+  static const struct
+  {
+    GstVideoFormat format;
+    gint n_elems;
+    guint in_size, out_size;
+  } sizes[] = {
+    {GST_VIDEO_FORMAT_GRAY16_LE, 1, 1921, 1283},
+    {GST_VIDEO_FORMAT_GRAY16_LE, 1, 1283, 1921},
+    {GST_VIDEO_FORMAT_AYUV64, 4, 1921, 1283},
+    {GST_VIDEO_FORMAT_AYUV64, 4, 1283, 1921},
+  };
+  GTimer *timer;
+  gint i, j;
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    GstVideoScaler *hscale, *vscale;
+    guint16 *src, *dest, **lines;
+    guint in_offset, n_taps, max_taps;
+    gdouble elapsed;
+    gint count, size;
+
+    /* also used as a source line of out_size pixels for vertical scaling */
+    size = MAX (sizes[i].in_size, sizes[i].out_size) * sizes[i].n_elems;
+    src = g_new (guint16, size);
+    for (j = 0; j < size; j++)
+      src[j] = SCALER_VALUE;
+    dest = g_new0 (guint16, sizes[i].out_size * sizes[i].n_elems);
+
+    hscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, sizes[i].in_size, sizes[i].out_size,
+        NULL);
+    fail_unless (gst_video_scaler_get_max_taps (hscale) > 2);
+
+    gst_video_scaler_horizontal (hscale, sizes[i].format, src, dest, 0,
+        sizes[i].out_size);
+    check_scaled_line_u16 (dest, sizes[i].out_size * sizes[i].n_elems);
+
+    g_timer_start (timer);
+    count = 0;
+    do {
+      gst_video_scaler_horizontal (hscale, sizes[i].format, src, dest, 0,
+          sizes[i].out_size);
+      count++;
+      elapsed = g_timer_elapsed (timer, NULL);
+    } while (elapsed < TIME);
+    GST_DEBUG ("%f lines/sec horizontal %s %u -> %u", count / elapsed,
+        gst_video_format_to_string (sizes[i].format), sizes[i].in_size,
+        sizes[i].out_size);
+
+    /* scale the lines as columns, the source lines are all the same */
+    vscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+        GST_VIDEO_SCALER_FLAG_NONE, 0, sizes[i].in_size, sizes[i].out_size,
+        NULL);
+    max_taps = gst_video_scaler_get_max_taps (vscale);
+    fail_unless (max_taps > 2);
+
+    lines = g_new (guint16 *, max_taps);
+    for (j = 0; j < max_taps; j++)
+      lines[j] = src;
+
+    gst_video_scaler_get_coeff (vscale, sizes[i].out_size / 2, &in_offset,
+        &n_taps);
+    fail_unless (n_taps <= max_taps);
+    memset (dest, 0, sizeof (guint16) * sizes[i].out_size * sizes[i].n_elems);
+    gst_video_scaler_vertical (vscale, sizes[i].format, (gpointer *) lines,
+        dest, sizes[i].out_size / 2, sizes[i].out_size);
+    check_scaled_line_u16 (dest, sizes[i].out_size * sizes[i].n_elems);
+
+    g_timer_start (timer);
+    count = 0;
+    do {
+      gst_video_scaler_vertical (vscale, sizes[i].format, (gpointer *) lines,
+          dest, count % sizes[i].out_size, sizes[i].out_size);
+      count++;
+      elapsed = g_timer_elapsed (timer, NULL);
+    } while (elapsed < TIME);
+    GST_DEBUG ("%f lines/sec vertical %s %u taps", count / elapsed,
+        gst_video_format_to_string (sizes[i].format), max_taps);
+
+    g_free (lines);
+    gst_video_scaler_free (vscale);
+    gst_video_scaler_free (hscale);
+    g_free (dest);
+    g_free (src);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+#undef TIME
+
 typedef enum
 {
   RGB,
@@ -2700,6 +3013,82 @@ GST_END_TEST;
 #undef WIDTH
 #undef HEIGHT
 
+/* timings of common conversions at UHD resolution, single and multi
+ * threaded */
+GST_START_TEST (test_video_convert_format_pairs)
+{
+  static const struct
+  {
+    GstVideoFormat infmt;
+    gint in_width, in_height;
+    GstVideoFormat outfmt;
+    gint out_width, out_height;
+  } pairs[] = {
+    {GST_VIDEO_FORMAT_NV12, 3840, 2160, GST_VIDEO_FORMAT_I420, 3840, 2160},
+    {GST_VIDEO_FORMAT_v210, 3840, 2160, GST_VIDEO_FORMAT_NV12, 3840, 2160},
+    {GST_VIDEO_FORMAT_BGRA, 3840, 2160, GST_VIDEO_FORMAT_I420, 1920, 1080},
+    {GST_VIDEO_FORMAT_BGRA, 1920, 1080, GST_VIDEO_FORMAT_I420, 3840, 2160},
+  };
+  GTimer *timer;
+  gint i, n_threads;
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < G_N_ELEMENTS (pairs); i++) {
+    GstVideoInfo ininfo, outinfo;
+    GstVideoFrame inframe, outframe;
+    GstBuffer *inbuffer, *outbuffer;
+
+    fail_unless (gst_video_info_set_format (&ininfo, pairs[i].infmt,
+            pairs[i].in_width, pairs[i].in_height));
+    inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+    gst_buffer_memset (inbuffer, 0, 0, -1);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+    fail_unless (gst_video_info_set_format (&outinfo, pairs[i].outfmt,
+            pairs[i].out_width, pairs[i].out_height));
+    outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+    gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+    for (n_threads = 1; n_threads <= 4; n_threads *= 4) {
+      GstVideoConverter *convert;
+      gdouble elapsed;
+      gint count = 0;
+
+      convert = gst_video_converter_new (&ininfo, &outinfo,
+          gst_structure_new ("options",
+              GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+
+      /* warmup */
+      gst_video_converter_frame (convert, &inframe, &outframe);
+
+      g_timer_start (timer);
+      do {
+        gst_video_converter_frame (convert, &inframe, &outframe);
+        count++;
+        elapsed = g_timer_elapsed (timer, NULL);
+      } while (elapsed < TIME);
+
+      GST_DEBUG ("%f frames/sec %s %dx%d -> %s %dx%d, %d threads",
+          count / elapsed, gst_video_format_to_string (pairs[i].infmt),
+          pairs[i].in_width, pairs[i].in_height,
+          gst_video_format_to_string (pairs[i].outfmt), pairs[i].out_width,
+          pairs[i].out_height, n_threads);
+
+      gst_video_converter_free (convert);
+    }
+
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_convert)
 {
   GstVideoInfo ininfo, outinfo;
@@ -2849,6 +3238,278 @@ GST_START_TEST (test_video_convert_with_config_update)
 
 GST_END_TEST;
 
+static void
+convert_frame_to_format (GstVideoFrame * inframe, GstVideoFrame * outframe,
+    GstBuffer ** outbuffer, GstVideoFormat format, guint n_threads)
+{
+  GstVideoConverter *convert;
+  GstVideoInfo outinfo;
+
+  fail_unless (gst_video_info_set_format (&outinfo, format,
+          GST_VIDEO_FRAME_WIDTH (inframe), GST_VIDEO_FRAME_HEIGHT (inframe)));
+  *outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (outframe, &outinfo, *outbuffer, GST_MAP_WRITE);
+
+  convert = gst_video_converter_new (&inframe->info, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+  gst_video_converter_frame (convert, inframe, outframe);
+  gst_video_converter_free (convert);
+}
+
+/* I420 <-> NV12 only shuffle the chroma samples, so going around through
+ * all the variants must give back the original frame */
+GST_START_TEST (test_video_convert_I420_NV12)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_NV21, GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12,
+    GST_VIDEO_FORMAT_I420
+  };
+  GstVideoInfo info;
+  GstVideoFrame inframe, frame, outframe;
+  GstBuffer *inbuffer, *buffer, *outbuffer;
+  guint n_threads;
+  gint i, j, k;
+
+  fail_unless (gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 321,
+          243));
+  inbuffer = gst_buffer_new_and_alloc (info.size);
+  gst_video_frame_map (&inframe, &info, inbuffer, GST_MAP_READWRITE);
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, i); j++) {
+      guint8 *line = GST_VIDEO_FRAME_COMP_DATA (&inframe, i) +
+          j * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, i);
+
+      for (k = 0; k < GST_VIDEO_FRAME_COMP_WIDTH (&inframe, i); k++)
+        line[k] = i * 85 + j * 7 + k * 3;
+    }
+  }
+
+  for (n_threads = 1; n_threads <= 3; n_threads += 2) {
+    gst_video_frame_map (&frame, &info, inbuffer, GST_MAP_READ);
+    buffer = gst_buffer_ref (inbuffer);
+
+    for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+      convert_frame_to_format (&frame, &outframe, &outbuffer, formats[i],
+          n_threads);
+      gst_video_frame_unmap (&frame);
+      gst_buffer_unref (buffer);
+      frame = outframe;
+      buffer = outbuffer;
+    }
+
+    for (i = 0; i < 3; i++) {
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, i); j++) {
+        fail_unless (memcmp (GST_VIDEO_FRAME_COMP_DATA (&inframe, i) +
+                j * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, i),
+                GST_VIDEO_FRAME_COMP_DATA (&frame, i) +
+                j * GST_VIDEO_FRAME_COMP_STRIDE (&frame, i),
+                GST_VIDEO_FRAME_COMP_WIDTH (&inframe, i)) == 0,
+            "component %d line %d differs", i, j);
+      }
+    }
+    gst_video_frame_unmap (&frame);
+    gst_buffer_unref (buffer);
+  }
+
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
+/* At width 2048 the 16 bits per component temporary lines get a padded
+ * stride. The columns that don't depend on the right edge must be the same
+ * as when converting the same picture cropped to 2040 columns, which needs
+ * no padding, with any number of threads */
+GST_START_TEST (test_video_convert_padded_lines)
+{
+  GstVideoInfo info, cropinfo;
+  GstVideoFrame inframe, cropframe, outframe, cropoutframe;
+  GstBuffer *inbuffer, *cropbuffer, *outbuffer, *cropoutbuffer;
+  guint n_threads;
+  gint i, j, k;
+
+  fail_unless (gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420_10LE,
+          2048, 64));
+  inbuffer = gst_buffer_new_and_alloc (info.size);
+  gst_video_frame_map (&inframe, &info, inbuffer, GST_MAP_READWRITE);
+
+  fail_unless (gst_video_info_set_format (&cropinfo,
+          GST_VIDEO_FORMAT_I420_10LE, 2040, 64));
+  cropbuffer = gst_buffer_new_and_alloc (cropinfo.size);
+  gst_video_frame_map (&cropframe, &cropinfo, cropbuffer, GST_MAP_READWRITE);
+
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, i); j++) {
+      guint8 *line = GST_VIDEO_FRAME_COMP_DATA (&inframe, i) +
+          j * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, i);
+
+      for (k = 0; k < GST_VIDEO_FRAME_COMP_WIDTH (&inframe, i); k++)
+        GST_WRITE_UINT16_LE (line + k * 2, (i * 341 + j * 7 + k * 13) & 0x3ff);
+
+      memcpy (GST_VIDEO_FRAME_COMP_DATA (&cropframe, i) +
+          j * GST_VIDEO_FRAME_COMP_STRIDE (&cropframe, i), line,
+          GST_VIDEO_FRAME_COMP_WIDTH (&cropframe, i) * 2);
+    }
+  }
+
+  for (n_threads = 1; n_threads <= 4; n_threads *= 4) {
+    convert_frame_to_format (&inframe, &outframe, &outbuffer,
+        GST_VIDEO_FORMAT_Y444_16LE, n_threads);
+    convert_frame_to_format (&cropframe, &cropoutframe, &cropoutbuffer,
+        GST_VIDEO_FORMAT_Y444_16LE, n_threads);
+
+    /* leave some columns for the chroma upsampling at the edge */
+    for (i = 0; i < 3; i++) {
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_HEIGHT (&outframe, i); j++) {
+        fail_unless (memcmp (GST_VIDEO_FRAME_COMP_DATA (&outframe, i) +
+                j * GST_VIDEO_FRAME_COMP_STRIDE (&outframe, i),
+                GST_VIDEO_FRAME_COMP_DATA (&cropoutframe, i) +
+                j * GST_VIDEO_FRAME_COMP_STRIDE (&cropoutframe, i),
+                2032 * 2) == 0, "%u threads, component %d line %d differs",
+            n_threads, i, j);
+      }
+    }
+
+    gst_video_frame_unmap (&cropoutframe);
+    gst_buffer_unref (cropoutbuffer);
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+  }
+
+  gst_video_frame_unmap (&cropframe);
+  gst_buffer_unref (cropbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_convert_YUY2_NV12)
+{
+  GstVideoInfo info;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  guint n_threads;
+  gint i, j;
+
+  fail_unless (gst_video_info_set_format (&info, GST_VIDEO_FORMAT_YUY2, 321,
+          62));
+  inbuffer = gst_buffer_new_and_alloc (info.size);
+  gst_video_frame_map (&inframe, &info, inbuffer, GST_MAP_READWRITE);
+  for (i = 0; i < 62; i++) {
+    guint8 *line = GST_VIDEO_FRAME_PLANE_DATA (&inframe, 0) +
+        i * GST_VIDEO_FRAME_PLANE_STRIDE (&inframe, 0);
+
+    for (j = 0; j < 161; j++) {
+      line[j * 4 + 0] = i;
+      line[j * 4 + 1] = 2 * i;
+      line[j * 4 + 2] = i;
+      line[j * 4 + 3] = 255 - i;
+    }
+  }
+
+  for (n_threads = 1; n_threads <= 3; n_threads += 2) {
+    convert_frame_to_format (&inframe, &outframe, &outbuffer,
+        GST_VIDEO_FORMAT_NV12, n_threads);
+
+    for (i = 0; i < 62; i++) {
+      guint8 *y = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0) +
+          i * GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0);
+
+      for (j = 0; j < 321; j++)
+        fail_unless_equals_int (y[j], i);
+    }
+    /* the chroma of two lines is averaged */
+    for (i = 0; i < 31; i++) {
+      guint8 *uv = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 1) +
+          i * GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 1);
+
+      for (j = 0; j < 161; j++) {
+        fail_unless_equals_int (uv[j * 2 + 0], 4 * i + 1);
+        fail_unless_equals_int (uv[j * 2 + 1], 255 - 2 * i);
+      }
+    }
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+  }
+
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
+/* the color LUT must give about the same result as the per pixel conversion
+ * with gamma remapping */
+GST_START_TEST (test_video_convert_color_lut)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe, refframe;
+  GstBuffer *inbuffer, *outbuffer, *refbuffer;
+  GstVideoConverter *convert;
+  gint i, j, k;
+
+  fail_unless (gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 320,
+          240));
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_buffer_memset (inbuffer, 0, 128, -1);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READWRITE);
+  for (i = 0; i < 240; i++) {
+    guint8 *y = GST_VIDEO_FRAME_COMP_DATA (&inframe, 0) +
+        i * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, 0);
+
+    for (j = 0; j < 320; j++)
+      y[j] = 32 + (j * 191) / 319;
+  }
+
+  fail_unless (gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_RGBA, 320,
+          240));
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  refbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+  gst_video_frame_map (&refframe, &outinfo, refbuffer, GST_MAP_WRITE);
+
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_GAMMA_MODE, GST_TYPE_VIDEO_GAMMA_MODE,
+          GST_VIDEO_GAMMA_MODE_REMAP, NULL));
+  gst_video_converter_frame (convert, &inframe, &refframe);
+  gst_video_converter_free (convert);
+
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_GAMMA_MODE, GST_TYPE_VIDEO_GAMMA_MODE,
+          GST_VIDEO_GAMMA_MODE_REMAP,
+          GST_VIDEO_CONVERTER_OPT_COLOR_LUT_SIZE, G_TYPE_UINT, 33, NULL));
+  gst_video_converter_frame (convert, &inframe, &outframe);
+  gst_video_converter_free (convert);
+
+  for (i = 0; i < 240; i++) {
+    guint8 *o = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0) +
+        i * GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0);
+    guint8 *r = GST_VIDEO_FRAME_PLANE_DATA (&refframe, 0) +
+        i * GST_VIDEO_FRAME_PLANE_STRIDE (&refframe, 0);
+
+    for (j = 0; j < 320; j++) {
+      for (k = 0; k < 4; k++)
+        fail_unless (ABS (o[j * 4 + k] - r[j * 4 + k]) <= 3,
+            "pixel %d,%d component %d: %d != %d", j, i, k, o[j * 4 + k],
+            r[j * 4 + k]);
+    }
+  }
+
+  gst_video_frame_unmap (&refframe);
+  gst_video_frame_unmap (&outframe);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (refbuffer);
+  gst_buffer_unref (outbuffer);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_convert_multithreading)
 {
   GstVideoInfo ininfo, outinfo;
@@ -3229,6 +3890,122 @@ GST_START_TEST (test_overlay_composition_over_transparency)
 
 GST_END_TEST;
 
+static void
+fill_overlay_blend_frame (GstVideoFrame * frame)
+{
+  gint i, j, c;
+
+  /* chroma is sampled at the top-left pixel of each block, so that 4:2:0
+   * and 4:4:4 frames contain the same picture */
+  for (c = 0; c < 3; c++) {
+    gint w = GST_VIDEO_FRAME_COMP_WIDTH (frame, c);
+    gint h = GST_VIDEO_FRAME_COMP_HEIGHT (frame, c);
+    gint ws = GST_VIDEO_FRAME_WIDTH (frame) / w;
+    gint hs = GST_VIDEO_FRAME_HEIGHT (frame) / h;
+    guint8 *data = GST_VIDEO_FRAME_COMP_DATA (frame, c);
+    gint stride = GST_VIDEO_FRAME_COMP_STRIDE (frame, c);
+    gint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c);
+
+    for (j = 0; j < h; j++)
+      for (i = 0; i < w; i++)
+        data[j * stride + i * pstride] = (i * ws * (c + 1) + j * hs) & 0xff;
+  }
+}
+
+static void
+blend_overlay_onto (GstVideoOverlayComposition * comp, GstVideoFormat format,
+    guint n_threads, GstVideoFrame * frame)
+{
+  GstVideoInfo info;
+  GstBuffer *buf;
+
+  fail_unless (gst_video_info_set_format (&info, format, 320, 240));
+  buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&info));
+  fail_unless (gst_video_frame_map (frame, &info, buf, GST_MAP_READWRITE));
+  gst_buffer_unref (buf);
+
+  fill_overlay_blend_frame (frame);
+  fail_unless (gst_video_overlay_composition_blend_with_pool (comp, frame,
+          n_threads, NULL));
+}
+
+/* blending onto 4:2:0 frames goes directly into the planes, check that
+ * it gives the same result as the generic path on a 4:4:4 frame and that
+ * it does not depend on the number of threads */
+GST_START_TEST (test_overlay_blend_420)
+{
+  GstVideoFormat formats[] = { GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV21 };
+  GstVideoOverlayComposition *comp;
+  GstVideoOverlayRectangle *rect, *scaled_rect;
+  GstVideoFrame ref, frame, frame_mt;
+  GstBuffer *pix;
+  GstMapInfo map;
+  gint f, c, i, j;
+
+  pix = gst_buffer_new_and_alloc (101 * 77 * 4);
+  gst_buffer_map (pix, &map, GST_MAP_WRITE);
+  for (j = 0; j < 77; j++) {
+    for (i = 0; i < 101; i++) {
+      guint8 *p = map.data + (j * 101 + i) * 4;
+
+      p[0] = i * 7;
+      p[1] = j * 5;
+      p[2] = (i + j) * 3;
+      p[3] = (i * j) & 0xff;
+    }
+  }
+  gst_buffer_unmap (pix, &map);
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 101, 77);
+
+  /* odd position and size, partially outside of the frame */
+  rect = gst_video_overlay_rectangle_new_raw (pix, 33, 17, 101, 77,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  gst_video_overlay_rectangle_set_global_alpha (rect, 0.75);
+  scaled_rect = gst_video_overlay_rectangle_new_raw (pix, 251, 199, 202, 154,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  comp = gst_video_overlay_composition_new (rect);
+  gst_video_overlay_composition_add_rectangle (comp, scaled_rect);
+  gst_buffer_unref (pix);
+
+  blend_overlay_onto (comp, GST_VIDEO_FORMAT_Y444, 1, &ref);
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    blend_overlay_onto (comp, formats[f], 1, &frame);
+    blend_overlay_onto (comp, formats[f], 3, &frame_mt);
+
+    for (c = 0; c < 3; c++) {
+      gint w = GST_VIDEO_FRAME_COMP_WIDTH (&frame, c);
+      gint h = GST_VIDEO_FRAME_COMP_HEIGHT (&frame, c);
+      gint ws = GST_VIDEO_FRAME_WIDTH (&frame) / w;
+      gint hs = GST_VIDEO_FRAME_HEIGHT (&frame) / h;
+
+      for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+          guint8 *r = GST_VIDEO_FRAME_COMP_DATA (&ref, c);
+          guint8 *d = GST_VIDEO_FRAME_COMP_DATA (&frame, c);
+          guint8 *m = GST_VIDEO_FRAME_COMP_DATA (&frame_mt, c);
+          gint roff = j * hs * GST_VIDEO_FRAME_COMP_STRIDE (&ref, c) + i * ws;
+          gint off = j * GST_VIDEO_FRAME_COMP_STRIDE (&frame, c) +
+              i * GST_VIDEO_FRAME_COMP_PSTRIDE (&frame, c);
+
+          fail_unless_equals_int (d[off], r[roff]);
+          fail_unless_equals_int (m[off], d[off]);
+        }
+      }
+    }
+    gst_video_frame_unmap (&frame);
+    gst_video_frame_unmap (&frame_mt);
+  }
+  gst_video_frame_unmap (&ref);
+
+  gst_video_overlay_composition_unref (comp);
+  gst_video_overlay_rectangle_unref (scaled_rect);
+  gst_video_overlay_rectangle_unref (rect);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_format_enum_stability)
 {
   /* When adding new formats, adding a format in the middle of the enum will
@@ -4310,6 +5087,76 @@ GST_START_TEST (test_video_meta_serialize)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_frame_map_pool_buffer)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstVideoInfo info;
+  GstVideoFrame frame;
+  GstVideoMeta *meta;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstCaps *caps;
+  gint i, refcount;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 64, 48);
+  caps = gst_video_info_to_caps (&info);
+
+  pool = gst_video_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, info.size, 0, 0);
+  gst_buffer_pool_config_add_option (config,
+      GST_BUFFER_POOL_OPTION_VIDEO_META);
+  fail_unless (gst_buffer_pool_set_config (pool, config));
+  fail_unless (gst_buffer_pool_set_active (pool, TRUE));
+  gst_caps_unref (caps);
+
+  fail_unless (gst_buffer_pool_acquire_buffer (pool, &buf,
+          NULL) == GST_FLOW_OK);
+  meta = gst_buffer_get_video_meta (buf);
+  fail_unless (meta != NULL);
+  fail_unless_equals_int (gst_buffer_n_memory (buf), 1);
+  mem = gst_buffer_peek_memory (buf, 0);
+  refcount = GST_MINI_OBJECT_REFCOUNT_VALUE (mem);
+
+  /* all planes point into the single memory of the buffer */
+  fail_unless (gst_video_frame_map (&frame, &info, buf, GST_MAP_READ));
+  fail_unless (frame.meta == meta);
+  /* which was mapped, and so referenced, once for all planes instead of
+   * once per plane */
+  fail_unless_equals_int (GST_MINI_OBJECT_REFCOUNT_VALUE (mem), refcount + 1);
+  for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (&frame); i++) {
+    fail_unless (frame.map[i].memory == mem);
+    fail_unless (GST_VIDEO_FRAME_PLANE_DATA (&frame, i) ==
+        (guint8 *) frame.map[0].data + meta->offset[i]);
+    fail_unless_equals_int (GST_VIDEO_FRAME_PLANE_STRIDE (&frame, i),
+        meta->stride[i]);
+  }
+
+  /* the memory could not be mapped for writing if it was still mapped for
+   * reading */
+  gst_video_frame_unmap (&frame);
+  fail_unless_equals_int (GST_MINI_OBJECT_REFCOUNT_VALUE (mem), refcount);
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  gst_buffer_unmap (buf, &map);
+
+  fail_unless (gst_video_frame_map (&frame, &info, buf, GST_MAP_WRITE));
+  memset (GST_VIDEO_FRAME_PLANE_DATA (&frame, 2), 0x80,
+      GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 2));
+  gst_video_frame_unmap (&frame);
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_READ));
+  fail_unless_equals_int (map.data[meta->offset[2]], 0x80);
+  gst_buffer_unmap (buf, &map);
+
+  gst_buffer_unref (buf);
+  gst_buffer_pool_set_active (pool, FALSE);
+  gst_object_unref (pool);
+}
+
+GST_END_TEST;
+
 static Suite *
 video_suite (void)
 {
@@ -4325,6 +5172,7 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_formats_rgba_large_dimension);
   tcase_add_test (tc_chain, test_video_formats_all);
   tcase_add_test (tc_chain, test_video_formats_pack_unpack);
+  tcase_add_test (tc_chain, test_video_formats_pack_unpack_high_depth);
   tcase_add_test (tc_chain, test_guess_framerate);
   tcase_add_test (tc_chain, test_dar_calc);
   tcase_add_test (tc_chain, test_parse_caps_rgb);
@@ -4343,18 +5191,25 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_chroma);
   tcase_add_test (tc_chain, test_video_chroma_site);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_ntap_u16);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_rgb);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_yuv);
   tcase_add_test (tc_chain, test_video_color_convert_yuv_yuv);
   tcase_add_test (tc_chain, test_video_color_convert_yuv_rgb);
   tcase_add_test (tc_chain, test_video_color_convert_other);
   tcase_add_test (tc_chain, test_video_size_convert);
+  tcase_add_test (tc_chain, test_video_convert_format_pairs);
+  tcase_add_test (tc_chain, test_video_convert_padded_lines);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_I420_NV12);
+  tcase_add_test (tc_chain, test_video_convert_YUY2_NV12);
+  tcase_add_test (tc_chain, test_video_convert_color_lut);
   tcase_add_test (tc_chain, test_video_convert_multithreading);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);
   tcase_add_test (tc_chain, test_overlay_composition_over_transparency);
+  tcase_add_test (tc_chain, test_overlay_blend_420);
   tcase_add_test (tc_chain, test_video_format_enum_stability);
   tcase_add_test (tc_chain, test_video_formats_pstrides);
   tcase_add_test (tc_chain, test_hdr);
@@ -4370,6 +5225,7 @@ video_suite (void)
   tcase_add_test (tc_chain, test_info_dma_drm);
   tcase_add_test (tc_chain, test_video_meta_serialize);
   tcase_add_test (tc_chain, test_video_convert_with_config_update);
+  tcase_add_test (tc_chain, test_video_frame_map_pool_buffer);
 
   return s;
 }
@@ -0,0 +1,226 @@
+/* GStreamer
+ *
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/check/gstcheck.h>
+#include <string.h>
+
+/* The SSE4.1 kernels are selected once per process by the scaler, so they
+ * are called directly here and compared with the ORC code that the scaler
+ * uses otherwise */
+#if defined HAVE_ORC && !defined DISABLE_ORC && \
+    (defined (__i386__) || defined (__x86_64__)) && \
+    defined (HAVE_SMMINTRIN_H) && defined (HAVE_EMMINTRIN_H)
+#define CHECK_SSE41
+#include <orc/orc.h>
+#include "video-orc.h"
+#include "video-scaler-x86-sse41.h"
+#endif
+
+#define MAX_TAPS 16
+
+#ifdef CHECK_SSE41
+/* same check as video_scaler_init() */
+static gboolean
+have_sse41 (void)
+{
+  OrcTarget *target;
+  unsigned int flags;
+  gint i;
+
+  orc_init ();
+
+  target = orc_target_get_default ();
+  if (target == NULL)
+    return FALSE;
+
+  flags = orc_target_get_default_flags (target);
+  for (i = 0; i < 32; i++) {
+    if ((flags & (1U << i)) &&
+        !strcmp (orc_target_get_flag_name (target, i), "sse41"))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+static void
+fill_pixels (GRand * rand, guint16 * pixels, gint n)
+{
+  gint i;
+
+  for (i = 0; i < n; i++)
+    pixels[i] = g_rand_int_range (rand, 0, 65536);
+}
+
+/* large enough to make the sums leave the 16 bits range on both sides, but
+ * small enough to not overflow with MAX_TAPS */
+static void
+fill_taps (GRand * rand, gint16 * taps, gint n)
+{
+  gint i;
+
+  for (i = 0; i < n; i++)
+    taps[i] = g_rand_int_range (rand, -2048, 2048);
+}
+
+static const gint counts[] = { 1, 7, 8, 9, 15, 16, 17, 1927 };
+#endif
+
+GST_START_TEST (test_scale_v_ntap_u16_sse41)
+{
+#ifdef CHECK_SSE41
+  GRand *rand;
+  gint i, j, k, n_taps, src_inc;
+
+  if (!have_sse41 ()) {
+    GST_INFO ("SSE4.1 not supported, skipping");
+    return;
+  }
+
+  rand = g_rand_new_with_seed (0);
+
+  for (i = 0; i < G_N_ELEMENTS (counts); i++) {
+    gint count = counts[i];
+    guint16 *lines[2 * MAX_TAPS];
+    gint16 taps[MAX_TAPS];
+    guint16 *orc_out, *sse_out;
+    gint32 *temp;
+
+    for (j = 0; j < 2 * MAX_TAPS; j++)
+      lines[j] = g_new (guint16, count);
+    orc_out = g_new (guint16, count);
+    sse_out = g_new (guint16, count);
+    temp = g_new (gint32, count);
+
+    for (src_inc = 1; src_inc <= 2; src_inc++) {
+      for (n_taps = 1; n_taps <= MAX_TAPS; n_taps++) {
+        for (j = 0; j < 2 * MAX_TAPS; j++)
+          fill_pixels (rand, lines[j], count);
+        fill_taps (rand, taps, n_taps);
+
+        /* as in video_scale_v_ntap_u16() */
+        video_orc_resample_v_multaps_u16 (temp, lines[0], taps[0], count);
+        for (j = 1; j < n_taps; j++)
+          video_orc_resample_v_muladdtaps_u16 (temp, lines[j * src_inc],
+              taps[j], count);
+        video_orc_resample_scaletaps_u16 (orc_out, temp, count);
+
+        memset (sse_out, 0, count * sizeof (guint16));
+        video_scale_v_ntap_u16_sse41 (sse_out, (gpointer *) lines, src_inc,
+            taps, n_taps, count);
+
+        for (k = 0; k < count; k++) {
+          fail_unless (sse_out[k] == orc_out[k],
+              "%d taps, src_inc %d, count %d, pixel %d: %u != %u", n_taps,
+              src_inc, count, k, sse_out[k], orc_out[k]);
+        }
+      }
+    }
+
+    for (j = 0; j < 2 * MAX_TAPS; j++)
+      g_free (lines[j]);
+    g_free (orc_out);
+    g_free (sse_out);
+    g_free (temp);
+  }
+
+  g_rand_free (rand);
+#endif
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_scale_h_ntap_u16_sse41)
+{
+#ifdef CHECK_SSE41
+  GRand *rand;
+  gint i, k, n_taps;
+
+  if (!have_sse41 ()) {
+    GST_INFO ("SSE4.1 not supported, skipping");
+    return;
+  }
+
+  rand = g_rand_new_with_seed (0);
+
+  for (i = 0; i < G_N_ELEMENTS (counts); i++) {
+    gint count = counts[i];
+    guint16 *pixels, *orc_out, *sse_out;
+    gint16 *taps;
+    gint32 *temp;
+
+    /* one block of @count pixels and taps for each tap */
+    pixels = g_new (guint16, MAX_TAPS * count);
+    taps = g_new (gint16, MAX_TAPS * count);
+    orc_out = g_new (guint16, count);
+    sse_out = g_new (guint16, count);
+    temp = g_new (gint32, count);
+
+    for (n_taps = 1; n_taps <= MAX_TAPS; n_taps++) {
+      fill_pixels (rand, pixels, n_taps * count);
+      fill_taps (rand, taps, n_taps * count);
+
+      /* as in video_scale_h_ntap_u16() */
+      video_orc_resample_h_multaps_u16 (temp, pixels, taps, count);
+      video_orc_resample_h_muladdtaps_u16 (temp, 0, pixels + count, count * 2,
+          taps + count, count * 2, count, n_taps - 1);
+      video_orc_resample_scaletaps_u16 (orc_out, temp, count);
+
+      memset (sse_out, 0, count * sizeof (guint16));
+      video_scale_h_ntap_u16_sse41 (sse_out, pixels, taps, n_taps, count);
+
+      for (k = 0; k < count; k++) {
+        fail_unless (sse_out[k] == orc_out[k],
+            "%d taps, count %d, pixel %d: %u != %u", n_taps, count, k,
+            sse_out[k], orc_out[k]);
+      }
+    }
+
+    g_free (pixels);
+    g_free (taps);
+    g_free (orc_out);
+    g_free (sse_out);
+    g_free (temp);
+  }
+
+  g_rand_free (rand);
+#endif
+}
+
+GST_END_TEST;
+
+static Suite *
+gst_video_scaler_x86_suite (void)
+{
+  Suite *s = suite_create ("GstVideoScalerX86");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_scale_v_ntap_u16_sse41);
+  tcase_add_test (tc, test_scale_h_ntap_u16_sse41);
+
+  return s;
+}
+
+GST_CHECK_MAIN (gst_video_scaler_x86);
@@ -0,0 +1,181 @@
+/* GStreamer video format pack/unpack benchmark
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define DEFAULT_WIDTH 1920
+#define DEFAULT_HEIGHT 1080
+
+#define DEFAULT_DURATION 1.0
+
+static gint
+get_num_formats (void)
+{
+  gint num_formats = 200;
+
+  while (gst_video_format_to_string (num_formats) == NULL)
+    --num_formats;
+  GST_INFO ("number of known video formats: %d", num_formats);
+  return num_formats + 1;
+}
+
+/* unpacks or packs all lines of @frame, @lines holds pack_lines lines of
+ * the unpack format */
+static void
+process_frame (GstVideoFrame * frame, gpointer lines, gint lines_stride,
+    gboolean pack)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  gint width = GST_VIDEO_FRAME_WIDTH (frame);
+  gint height = GST_VIDEO_FRAME_HEIGHT (frame);
+  gint y, l;
+
+  for (y = 0; y < height; y += finfo->pack_lines) {
+    if (pack) {
+      finfo->pack_func (finfo, 0, lines, lines_stride, frame->data,
+          frame->info.stride, frame->info.chroma_site, y, width);
+    } else {
+      for (l = 0; l < finfo->pack_lines && y + l < height; l++)
+        finfo->unpack_func (finfo, 0, (guint8 *) lines + l * lines_stride,
+            frame->data, frame->info.stride, 0, y + l, width);
+    }
+  }
+}
+
+static gdouble
+benchmark_frame (GstVideoFrame * frame, gpointer lines, gint lines_stride,
+    gboolean pack, gdouble max_duration, GTimer * timer)
+{
+  gdouble elapsed;
+  gint count;
+
+  /* warmup */
+  process_frame (frame, lines, lines_stride, pack);
+
+  count = 0;
+  g_timer_start (timer);
+  while (TRUE) {
+    process_frame (frame, lines, lines_stride, pack);
+
+    count++;
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= max_duration)
+      break;
+  }
+
+  return count / elapsed;
+}
+
+static void
+do_benchmark_formats (guint width, guint height, const gchar * format,
+    gdouble max_duration)
+{
+  GstVideoFormat fmt;
+  GTimer *timer;
+  gint num_formats;
+
+  timer = g_timer_new ();
+
+  num_formats = get_num_formats ();
+
+  for (fmt = GST_VIDEO_FORMAT_I420; fmt < num_formats; fmt++) {
+    const GstVideoFormatInfo *finfo, *unpack_finfo;
+    const gchar *fmt_str;
+    GstVideoInfo info;
+    GstVideoFrame frame;
+    GstBuffer *buffer;
+    gpointer lines;
+    gint lines_stride;
+    gdouble unpack_sec, pack_sec, mpixels;
+
+    if (fmt == GST_VIDEO_FORMAT_DMA_DRM)
+      continue;
+
+    fmt_str = gst_video_format_to_string (fmt);
+    if (format != NULL && !g_str_equal (format, fmt_str))
+      continue;
+
+    if (!gst_video_info_set_format (&info, fmt, width, height))
+      continue;
+
+    finfo = info.finfo;
+    unpack_finfo = gst_video_format_get_info (finfo->unpack_format);
+    lines_stride = GST_ROUND_UP_16 (width * unpack_finfo->pixel_stride[0]);
+    lines = g_malloc0 (lines_stride * finfo->pack_lines);
+
+    buffer = gst_buffer_new_and_alloc (info.size);
+    gst_buffer_memset (buffer, 0, 0, -1);
+    gst_video_frame_map (&frame, &info, buffer, GST_MAP_READWRITE);
+
+    unpack_sec = benchmark_frame (&frame, lines, lines_stride, FALSE,
+        max_duration, timer);
+    pack_sec = benchmark_frame (&frame, lines, lines_stride, TRUE,
+        max_duration, timer);
+    mpixels = (gdouble) width * height / 1000000.0;
+
+    gst_println ("%-16s unpack %8.1f frames/sec %8.1f Mpixels/sec, "
+        "pack %8.1f frames/sec %8.1f Mpixels/sec @ %ux%u", fmt_str,
+        unpack_sec, unpack_sec * mpixels, pack_sec, pack_sec * mpixels,
+        width, height);
+
+    gst_video_frame_unmap (&frame);
+    gst_buffer_unref (buffer);
+    g_free (lines);
+  }
+
+  g_timer_destroy (timer);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gint width = DEFAULT_WIDTH;
+  gint height = DEFAULT_HEIGHT;
+  gdouble max_dur = DEFAULT_DURATION;
+  gchar *fmt = NULL;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"width", 'w', 0, G_OPTION_ARG_INT, &width, "Width", NULL},
+    {"height", 'h', 0, G_OPTION_ARG_INT, &height, "Height", NULL},
+    {"format", 'f', 0, G_OPTION_ARG_STRING, &fmt, "Format", NULL},
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each run (in seconds)", NULL},
+    {NULL}
+  };
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  do_benchmark_formats (width, height, fmt, max_dur);
+  return 0;
+}
@@ -388,50 +388,16 @@ gst_segment_do_seek (GstSegment * segment, gdouble rate,
   return TRUE;
 }
 
-/**
- * gst_segment_to_stream_time_full:
- * @segment: a #GstSegment structure.
- * @format: the format of the segment.
- * @position: the position in the segment
- * @stream_time: (out): result stream-time
- *
- * Translate @position to the total stream time using the currently configured
- * segment. Compared to gst_segment_to_stream_time() this function can return
- * negative stream-time.
- *
- * This function is typically used by elements that need to synchronize buffers
- * against the clock or each other.
- *
- * @position can be any value and the result of this function for values outside
- * of the segment is extrapolated.
- *
- * When 1 is returned, @position resulted in a positive stream-time returned
- * in @stream_time.
- *
- * When this function returns -1, the returned @stream_time should be negated
- * to get the real negative stream time.
- *
- * Returns: a 1 or -1 on success, 0 on failure.
- *
- * Since: 1.8
- */
-gint
-gst_segment_to_stream_time_full (const GstSegment * segment, GstFormat format,
+/* conversion without the argument checks, for use by the public functions
+ * that already did them. @position must not be -1 */
+static inline gint
+segment_to_stream_time_unchecked (const GstSegment * segment,
     guint64 position, guint64 * stream_time)
 {
   guint64 start, stop, time;
   gdouble abs_applied_rate;
   gint res;
 
-  /* format does not matter for -1 */
-  if (G_UNLIKELY (position == -1)) {
-    *stream_time = -1;
-    return 0;
-  }
-
-  g_return_val_if_fail (segment != NULL, 0);
-  g_return_val_if_fail (segment->format == format, 0);
-
   stop = segment->stop;
 
   start = segment->start;
@@ -441,6 +407,12 @@ gst_segment_to_stream_time_full (const GstSegment * segment, GstFormat format,
   if (G_UNLIKELY (time == -1))
     return 0;
 
+  /* common case of unmodified data inside the segment */
+  if (G_LIKELY (segment->applied_rate == 1.0 && position >= start)) {
+    *stream_time = position - start + time;
+    return 1;
+  }
+
   abs_applied_rate = ABS (segment->applied_rate);
 
   /* add or subtract from segment time based on applied rate */
@@ -496,6 +468,49 @@ gst_segment_to_stream_time_full (const GstSegment * segment, GstFormat format,
   return res;
 }
 
+/**
+ * gst_segment_to_stream_time_full:
+ * @segment: a #GstSegment structure.
+ * @format: the format of the segment.
+ * @position: the position in the segment
+ * @stream_time: (out): result stream-time
+ *
+ * Translate @position to the total stream time using the currently configured
+ * segment. Compared to gst_segment_to_stream_time() this function can return
+ * negative stream-time.
+ *
+ * This function is typically used by elements that need to synchronize buffers
+ * against the clock or each other.
+ *
+ * @position can be any value and the result of this function for values outside
+ * of the segment is extrapolated.
+ *
+ * When 1 is returned, @position resulted in a positive stream-time returned
+ * in @stream_time.
+ *
+ * When this function returns -1, the returned @stream_time should be negated
+ * to get the real negative stream time.
+ *
+ * Returns: a 1 or -1 on success, 0 on failure.
+ *
+ * Since: 1.8
+ */
+gint
+gst_segment_to_stream_time_full (const GstSegment * segment, GstFormat format,
+    guint64 position, guint64 * stream_time)
+{
+  /* format does not matter for -1 */
+  if (G_UNLIKELY (position == -1)) {
+    *stream_time = -1;
+    return 0;
+  }
+
+  g_return_val_if_fail (segment != NULL, 0);
+  g_return_val_if_fail (segment->format == format, 0);
+
+  return segment_to_stream_time_unchecked (segment, position, stream_time);
+}
+
 /**
  * gst_segment_to_stream_time:
  * @segment: a #GstSegment structure.
@@ -540,7 +555,10 @@ gst_segment_to_stream_time (const GstSegment * segment, GstFormat format,
     return -1;
   }
 
-  if (gst_segment_to_stream_time_full (segment, format, position, &result) == 1)
+  if (G_UNLIKELY (position == -1))
+    return -1;
+
+  if (segment_to_stream_time_unchecked (segment, position, &result) == 1)
     return result;
 
   return -1;
@@ -705,35 +723,10 @@ gst_segment_position_from_stream_time (const GstSegment * segment,
   return -1;
 }
 
-/**
- * gst_segment_to_running_time_full:
- * @segment: a #GstSegment structure.
- * @format: the format of the segment.
- * @position: the position in the segment
- * @running_time: (out) (allow-none): result running-time
- *
- * Translate @position to the total running time using the currently configured
- * segment. Compared to gst_segment_to_running_time() this function can return
- * negative running-time.
- *
- * This function is typically used by elements that need to synchronize buffers
- * against the clock or each other.
- *
- * @position can be any value and the result of this function for values outside
- * of the segment is extrapolated.
- *
- * When 1 is returned, @position resulted in a positive running-time returned
- * in @running_time.
- *
- * When this function returns -1, the returned @running_time should be negated
- * to get the real negative running time.
- *
- * Returns: a 1 or -1 on success, 0 on failure.
- *
- * Since: 1.6
- */
-gint
-gst_segment_to_running_time_full (const GstSegment * segment, GstFormat format,
+/* conversion without the argument checks, for use by the public functions
+ * that already did them. @position must not be -1 */
+static inline gint
+segment_to_running_time_unchecked (const GstSegment * segment,
     guint64 position, guint64 * running_time)
 {
   gint res = 0;
@@ -741,15 +734,18 @@ gst_segment_to_running_time_full (const GstSegment * segment, GstFormat format,
   guint64 start, stop, offset;
   gdouble abs_rate;
 
-  if (G_UNLIKELY (position == -1)) {
-    GST_DEBUG ("invalid position (-1)");
-    goto done;
-  }
+  offset = segment->offset;
 
-  g_return_val_if_fail (segment != NULL, 0);
-  g_return_val_if_fail (segment->format == format, 0);
+  /* common case of normal playback inside the segment */
+  if (G_LIKELY (segment->rate == 1.0)) {
+    start = segment->start + offset;
 
-  offset = segment->offset;
+    if (G_LIKELY (position >= start)) {
+      if (running_time)
+        *running_time = position - start + segment->base;
+      return 1;
+    }
+  }
 
   if (G_LIKELY (segment->rate > 0.0)) {
     start = segment->start + offset;
@@ -809,13 +805,50 @@ gst_segment_to_running_time_full (const GstSegment * segment, GstFormat format,
     }
   }
   return res;
+}
 
-done:
-  {
+/**
+ * gst_segment_to_running_time_full:
+ * @segment: a #GstSegment structure.
+ * @format: the format of the segment.
+ * @position: the position in the segment
+ * @running_time: (out) (allow-none): result running-time
+ *
+ * Translate @position to the total running time using the currently configured
+ * segment. Compared to gst_segment_to_running_time() this function can return
+ * negative running-time.
+ *
+ * This function is typically used by elements that need to synchronize buffers
+ * against the clock or each other.
+ *
+ * @position can be any value and the result of this function for values outside
+ * of the segment is extrapolated.
+ *
+ * When 1 is returned, @position resulted in a positive running-time returned
+ * in @running_time.
+ *
+ * When this function returns -1, the returned @running_time should be negated
+ * to get the real negative running time.
+ *
+ * Returns: a 1 or -1 on success, 0 on failure.
+ *
+ * Since: 1.6
+ */
+gint
+gst_segment_to_running_time_full (const GstSegment * segment, GstFormat format,
+    guint64 position, guint64 * running_time)
+{
+  if (G_UNLIKELY (position == -1)) {
+    GST_DEBUG ("invalid position (-1)");
     if (running_time)
       *running_time = -1;
     return 0;
   }
+
+  g_return_val_if_fail (segment != NULL, 0);
+  g_return_val_if_fail (segment->format == format, 0);
+
+  return segment_to_running_time_unchecked (segment, position, running_time);
 }
 
 /**
@@ -859,8 +892,10 @@ gst_segment_to_running_time (const GstSegment * segment, GstFormat format,
     return -1;
   }
 
-  if (gst_segment_to_running_time_full (segment, format, position,
-          &result) == 1)
+  if (G_UNLIKELY (position == -1))
+    return -1;
+
+  if (segment_to_running_time_unchecked (segment, position, &result) == 1)
     return result;
 
   return -1;
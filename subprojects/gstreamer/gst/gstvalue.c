@@ -126,6 +126,14 @@ struct _GstValueSubtractInfo
   GstValueSubtractFunc func;
 };
 
+/* key of the union/intersect/subtract function indexes */
+typedef struct _GstValueTypePair GstValueTypePair;
+struct _GstValueTypePair
+{
+  GType type1;
+  GType type2;
+};
+
 struct _GstFlagSetClass
 {
   GTypeClass parent;
@@ -175,6 +183,11 @@ static GstValueTable *gst_value_tables_fundamental[FUNDAMENTAL_TYPE_ID_MAX + 1];
 static GArray *gst_value_union_funcs;
 static GArray *gst_value_intersect_funcs;
 static GArray *gst_value_subtract_funcs;
+/* (type1, type2) -> position + 1 in the arrays above, so that the functions
+ * for a pair of types are found without walking the arrays */
+static GHashTable *gst_value_union_index;
+static GHashTable *gst_value_intersect_index;
+static GHashTable *gst_value_subtract_index;
 
 /* Forward declarations */
 static gchar *gst_value_serialize_fraction (const GValue * value);
@@ -210,6 +223,77 @@ gst_value_hash_add_type (GType type, const GstValueTable * table)
   g_hash_table_insert (gst_value_hash, (gpointer) type, (gpointer) table);
 }
 
+static guint
+gst_value_type_pair_hash (gconstpointer key)
+{
+  const GstValueTypePair *pair = key;
+
+  return g_direct_hash ((gpointer) pair->type1) * 31 +
+      g_direct_hash ((gpointer) pair->type2);
+}
+
+static gboolean
+gst_value_type_pair_equal (gconstpointer a, gconstpointer b)
+{
+  const GstValueTypePair *pair_a = a, *pair_b = b;
+
+  return pair_a->type1 == pair_b->type1 && pair_a->type2 == pair_b->type2;
+}
+
+static GHashTable *
+gst_value_type_pair_index_new (void)
+{
+  return g_hash_table_new_full (gst_value_type_pair_hash,
+      gst_value_type_pair_equal, g_free, NULL);
+}
+
+/* only the first function registered for an ordered pair of types is
+ * indexed, see gst_value_type_pair_index_lookup_either() for pairs that were
+ * registered in both orders */
+static void
+gst_value_type_pair_index_add (GHashTable * index, GType type1, GType type2,
+    guint pos)
+{
+  GstValueTypePair *pair;
+
+  pair = g_new (GstValueTypePair, 1);
+  pair->type1 = type1;
+  pair->type2 = type2;
+
+  if (g_hash_table_contains (index, pair)) {
+    g_free (pair);
+    return;
+  }
+  g_hash_table_insert (index, pair, GUINT_TO_POINTER (pos + 1));
+}
+
+/* returns the position of the function for @type1 and @type2 or -1 */
+static inline gint
+gst_value_type_pair_index_lookup (GHashTable * index, GType type1, GType type2)
+{
+  GstValueTypePair pair = { type1, type2 };
+
+  return (gint) GPOINTER_TO_UINT (g_hash_table_lookup (index, &pair)) - 1;
+}
+
+/* returns the position of the function for @type1 and @type2 in either
+ * order or -1. If functions were registered for both orders, the one
+ * registered first is used like when walking the arrays, and @swapped tells
+ * whether it was registered for @type2 and @type1 */
+static inline gint
+gst_value_type_pair_index_lookup_either (GHashTable * index, GType type1,
+    GType type2, gboolean * swapped)
+{
+  gint pos, rpos;
+
+  pos = gst_value_type_pair_index_lookup (index, type1, type2);
+  rpos = gst_value_type_pair_index_lookup (index, type2, type1);
+
+  *swapped = rpos != -1 && (pos == -1 || rpos < pos);
+
+  return *swapped ? rpos : pos;
+}
+
 /********
  * list *
  ********/
@@ -6202,25 +6286,18 @@ gst_value_compare (const GValue * value1, const GValue * value2)
 gboolean
 gst_value_can_union (const GValue * value1, const GValue * value2)
 {
-  GstValueUnionInfo *union_info;
-  guint i, len;
+  GType type1, type2;
 
   g_return_val_if_fail (G_IS_VALUE (value1), FALSE);
   g_return_val_if_fail (G_IS_VALUE (value2), FALSE);
 
-  len = gst_value_union_funcs->len;
-
-  for (i = 0; i < len; i++) {
-    union_info = &g_array_index (gst_value_union_funcs, GstValueUnionInfo, i);
-    if (union_info->type1 == G_VALUE_TYPE (value1) &&
-        union_info->type2 == G_VALUE_TYPE (value2))
-      return TRUE;
-    if (union_info->type1 == G_VALUE_TYPE (value2) &&
-        union_info->type2 == G_VALUE_TYPE (value1))
-      return TRUE;
-  }
+  type1 = G_VALUE_TYPE (value1);
+  type2 = G_VALUE_TYPE (value2);
 
-  return FALSE;
+  return gst_value_type_pair_index_lookup (gst_value_union_index, type1,
+      type2) != -1
+      || gst_value_type_pair_index_lookup (gst_value_union_index, type2,
+      type1) != -1;
 }
 
 /**
@@ -6237,7 +6314,8 @@ gboolean
 gst_value_union (GValue * dest, const GValue * value1, const GValue * value2)
 {
   const GstValueUnionInfo *union_info;
-  guint i, len;
+  gint pos;
+  gboolean swapped;
   GType type1, type2;
 
   g_return_val_if_fail (dest != NULL, FALSE);
@@ -6246,18 +6324,16 @@ gst_value_union (GValue * dest, const GValue * value1, const GValue * value2)
   g_return_val_if_fail (gst_value_list_or_array_are_compatible (value1, value2),
       FALSE);
 
-  len = gst_value_union_funcs->len;
   type1 = G_VALUE_TYPE (value1);
   type2 = G_VALUE_TYPE (value2);
 
-  for (i = 0; i < len; i++) {
-    union_info = &g_array_index (gst_value_union_funcs, GstValueUnionInfo, i);
-    if (union_info->type1 == type1 && union_info->type2 == type2) {
-      return union_info->func (dest, value1, value2);
-    }
-    if (union_info->type1 == type2 && union_info->type2 == type1) {
+  pos = gst_value_type_pair_index_lookup_either (gst_value_union_index, type1,
+      type2, &swapped);
+  if (pos != -1) {
+    union_info = &g_array_index (gst_value_union_funcs, GstValueUnionInfo, pos);
+    if (swapped)
       return union_info->func (dest, value2, value1);
-    }
+    return union_info->func (dest, value1, value2);
   }
 
   gst_value_list_concat (dest, value1, value2);
@@ -6286,6 +6362,8 @@ gst_value_register_union_func (GType type1, GType type2, GstValueUnionFunc func)
   union_info.func = func;
 
   g_array_append_val (gst_value_union_funcs, union_info);
+  gst_value_type_pair_index_add (gst_value_union_index, type1, type2,
+      gst_value_union_funcs->len - 1);
 }
 
 /* intersection */
@@ -6304,8 +6382,6 @@ gst_value_register_union_func (GType type1, GType type2, GstValueUnionFunc func)
 gboolean
 gst_value_can_intersect (const GValue * value1, const GValue * value2)
 {
-  GstValueIntersectInfo *intersect_info;
-  guint i, len;
   GType type1, type2;
 
   g_return_val_if_fail (G_IS_VALUE (value1), FALSE);
@@ -6337,14 +6413,11 @@ gst_value_can_intersect (const GValue * value1, const GValue * value2)
 
   /* check registered intersect functions (only different gtype are checked at
    * this point) */
-  len = gst_value_intersect_funcs->len;
-  for (i = 0; i < len; i++) {
-    intersect_info = &g_array_index (gst_value_intersect_funcs,
-        GstValueIntersectInfo, i);
-    if ((intersect_info->type1 == type1 && intersect_info->type2 == type2) ||
-        (intersect_info->type1 == type2 && intersect_info->type2 == type1))
-      return TRUE;
-  }
+  if (gst_value_type_pair_index_lookup (gst_value_intersect_index, type1,
+          type2) != -1
+      || gst_value_type_pair_index_lookup (gst_value_intersect_index, type2,
+          type1) != -1)
+    return TRUE;
 
   return gst_value_can_compare_unchecked (value1, value2);
 }
@@ -6370,7 +6443,8 @@ gst_value_intersect (GValue * dest, const GValue * value1,
     const GValue * value2)
 {
   GstValueIntersectInfo *intersect_info;
-  guint i, len;
+  gint pos;
+  gboolean swapped;
   GType type1, type2;
 
   g_return_val_if_fail (G_IS_VALUE (value1), FALSE);
@@ -6411,16 +6485,14 @@ gst_value_intersect (GValue * dest, const GValue * value1,
       return gst_value_intersect_structure_structure (dest, value1, value2);
   } else {
     /* Different type comparison */
-    len = gst_value_intersect_funcs->len;
-    for (i = 0; i < len; i++) {
+    pos = gst_value_type_pair_index_lookup_either (gst_value_intersect_index,
+        type1, type2, &swapped);
+    if (pos != -1) {
       intersect_info = &g_array_index (gst_value_intersect_funcs,
-          GstValueIntersectInfo, i);
-      if (intersect_info->type1 == type1 && intersect_info->type2 == type2) {
-        return intersect_info->func (dest, value1, value2);
-      }
-      if (intersect_info->type1 == type2 && intersect_info->type2 == type1) {
+          GstValueIntersectInfo, pos);
+      if (swapped)
         return intersect_info->func (dest, value2, value1);
-      }
+      return intersect_info->func (dest, value1, value2);
     }
   }
 
@@ -6460,6 +6532,8 @@ gst_value_register_intersect_func (GType type1, GType type2,
   intersect_info.func = func;
 
   g_array_append_val (gst_value_intersect_funcs, intersect_info);
+  gst_value_type_pair_index_add (gst_value_intersect_index, type1, type2,
+      gst_value_intersect_funcs->len - 1);
 }
 
 
@@ -6484,7 +6558,7 @@ gst_value_subtract (GValue * dest, const GValue * minuend,
     const GValue * subtrahend)
 {
   GstValueSubtractInfo *info;
-  guint i, len;
+  gint pos;
   GType mtype, stype;
 
   g_return_val_if_fail (G_IS_VALUE (minuend), FALSE);
@@ -6499,12 +6573,11 @@ gst_value_subtract (GValue * dest, const GValue * minuend,
   if (stype == GST_TYPE_LIST)
     return gst_value_subtract_list (dest, minuend, subtrahend);
 
-  len = gst_value_subtract_funcs->len;
-  for (i = 0; i < len; i++) {
-    info = &g_array_index (gst_value_subtract_funcs, GstValueSubtractInfo, i);
-    if (info->minuend == mtype && info->subtrahend == stype) {
-      return info->func (dest, minuend, subtrahend);
-    }
+  pos = gst_value_type_pair_index_lookup (gst_value_subtract_index, mtype,
+      stype);
+  if (pos != -1) {
+    info = &g_array_index (gst_value_subtract_funcs, GstValueSubtractInfo, pos);
+    return info->func (dest, minuend, subtrahend);
   }
 
   if (_gst_value_compare_nolist (minuend, subtrahend) != GST_VALUE_EQUAL) {
@@ -6542,8 +6615,6 @@ gst_value_subtract (GValue * dest, const GValue * minuend,
 gboolean
 gst_value_can_subtract (const GValue * minuend, const GValue * subtrahend)
 {
-  GstValueSubtractInfo *info;
-  guint i, len;
   GType mtype, stype;
 
   g_return_val_if_fail (G_IS_VALUE (minuend), FALSE);
@@ -6558,12 +6629,9 @@ gst_value_can_subtract (const GValue * minuend, const GValue * subtrahend)
   if (mtype == GST_TYPE_STRUCTURE || stype == GST_TYPE_STRUCTURE)
     return FALSE;
 
-  len = gst_value_subtract_funcs->len;
-  for (i = 0; i < len; i++) {
-    info = &g_array_index (gst_value_subtract_funcs, GstValueSubtractInfo, i);
-    if (info->minuend == mtype && info->subtrahend == stype)
-      return TRUE;
-  }
+  if (gst_value_type_pair_index_lookup (gst_value_subtract_index, mtype,
+          stype) != -1)
+    return TRUE;
 
   return gst_value_can_compare_unchecked (minuend, subtrahend);
 }
@@ -6594,6 +6662,8 @@ gst_value_register_subtract_func (GType minuend_type, GType subtrahend_type,
   info.func = func;
 
   g_array_append_val (gst_value_subtract_funcs, info);
+  gst_value_type_pair_index_add (gst_value_subtract_index, minuend_type,
+      subtrahend_type, gst_value_subtract_funcs->len - 1);
 }
 
 /**
@@ -8312,6 +8382,9 @@ _priv_gst_value_initialize (void)
       sizeof (GstValueIntersectInfo), GST_VALUE_INTERSECT_TABLE_DEFAULT_SIZE);
   gst_value_subtract_funcs = g_array_sized_new (FALSE, FALSE,
       sizeof (GstValueSubtractInfo), GST_VALUE_SUBTRACT_TABLE_DEFAULT_SIZE);
+  gst_value_union_index = gst_value_type_pair_index_new ();
+  gst_value_intersect_index = gst_value_type_pair_index_new ();
+  gst_value_subtract_index = gst_value_type_pair_index_new ();
 
   REGISTER_SERIALIZATION (gst_int_range_get_type (), int_range);
   REGISTER_SERIALIZATION (gst_int64_range_get_type (), int64_range);
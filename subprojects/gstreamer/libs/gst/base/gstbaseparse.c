@@ -193,6 +193,9 @@
 #define TARGET_DIFFERENCE          (20 * GST_SECOND)
 #define MAX_INDEX_ENTRIES          4096
 #define UPDATE_THRESHOLD           2
+/* pull mode read-ahead, grows while reading sequentially */
+#define MIN_READ_AHEAD             (64 * 1024)
+#define MAX_READ_AHEAD             (1024 * 1024)
 
 #define ABSDIFF(a,b) (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
 
@@ -272,6 +275,7 @@ struct _GstBaseParsePrivate
   GQueue queued_frames;
 
   GstBuffer *cache;
+  guint cache_read_size;
 
   /* index entry storage, either ours or provided */
   GstIndex *index;
@@ -3365,6 +3369,7 @@ gst_base_parse_pull_range (GstBaseParse * parse, guint size,
     GstBuffer ** buffer)
 {
   GstFlowReturn ret = GST_FLOW_OK;
+  gboolean sequential = FALSE;
   guint read_size;
 
   g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
@@ -3386,12 +3391,24 @@ gst_base_parse_pull_range (GstBaseParse * parse, guint size,
       return GST_FLOW_OK;
     }
     /* not enough data in the cache, free cache and get a new one */
+    sequential = cache_offset <= parse->priv->offset &&
+        parse->priv->offset <= cache_offset + cache_size;
     gst_buffer_unref (parse->priv->cache);
     parse->priv->cache = NULL;
   }
 
+  /* when we ran past the end of the previous cache buffer we are most likely
+   * reading the file linearly, read ahead more so that the subclass gets to
+   * scan many frames per pull and upstream sees fewer, larger reads. Any
+   * jump in the offset (seeking, reverse playback) goes back to small reads */
+  if (sequential)
+    parse->priv->cache_read_size =
+        MIN (parse->priv->cache_read_size * 2, MAX_READ_AHEAD);
+  else
+    parse->priv->cache_read_size = MIN_READ_AHEAD;
+
   /* refill the cache */
-  read_size = MAX (64 * 1024, size);
+  read_size = MAX (parse->priv->cache_read_size, size);
   GST_LOG_OBJECT (parse,
       "Reading cache buffer of %u bytes from offset %" G_GINT64_FORMAT,
       read_size, parse->priv->offset);
@@ -3507,7 +3524,7 @@ gst_base_parse_scan_frame (GstBaseParse * parse, GstBaseParseClass * klass)
    * pull a new cache buffer */
   fsize = gst_base_parse_get_cached_available (parse);
   if (fsize < 1024)
-    fsize = 64 * 1024;
+    fsize = MIN_READ_AHEAD;
 
   while (TRUE) {
     min_size = MAX (parse->priv->min_frame_size, fsize);
@@ -1095,25 +1095,16 @@ gst_base_sink_set_last_buffer_list_unlocked (GstBaseSink * sink,
   }
 }
 
+/* sets both with a single lock, this is done for every rendered buffer */
 static void
-gst_base_sink_set_last_buffer (GstBaseSink * sink, GstBuffer * buffer)
+gst_base_sink_set_last_buffer_and_list (GstBaseSink * sink,
+    GstBuffer * buffer, GstBufferList * buffer_list)
 {
   if (!g_atomic_int_get (&sink->priv->enable_last_sample))
     return;
 
   GST_OBJECT_LOCK (sink);
   gst_base_sink_set_last_buffer_unlocked (sink, buffer);
-  GST_OBJECT_UNLOCK (sink);
-}
-
-static void
-gst_base_sink_set_last_buffer_list (GstBaseSink * sink,
-    GstBufferList * buffer_list)
-{
-  if (!g_atomic_int_get (&sink->priv->enable_last_sample))
-    return;
-
-  GST_OBJECT_LOCK (sink);
   gst_base_sink_set_last_buffer_list_unlocked (sink, buffer_list);
   GST_OBJECT_UNLOCK (sink);
 }
@@ -2491,14 +2482,13 @@ gst_base_sink_do_preroll (GstBaseSink * sink, GstMiniObject * obj)
 
       if (GST_IS_BUFFER_LIST (obj)) {
         buf = gst_buffer_list_get (GST_BUFFER_LIST_CAST (obj), 0);
-        gst_base_sink_set_last_buffer (sink, buf);
-        gst_base_sink_set_last_buffer_list (sink, GST_BUFFER_LIST_CAST (obj));
+        gst_base_sink_set_last_buffer_and_list (sink, buf,
+            GST_BUFFER_LIST_CAST (obj));
         g_assert (NULL != buf);
       } else if (GST_IS_BUFFER (obj)) {
         buf = GST_BUFFER_CAST (obj);
         /* For buffer lists do not set last buffer for now */
-        gst_base_sink_set_last_buffer (sink, buf);
-        gst_base_sink_set_last_buffer_list (sink, NULL);
+        gst_base_sink_set_last_buffer_and_list (sink, buf, NULL);
       } else {
         buf = NULL;
       }
@@ -2673,7 +2663,7 @@ gst_base_sink_do_sync (GstBaseSink * basesink,
   GstBaseSinkPrivate *priv;
   GstFlowReturn ret;
   GstStepInfo *current, *pending;
-  gboolean stepped;
+  gboolean stepped, sync;
   guint32 current_instant_rate_seqnum;
 
   priv = basesink->priv;
@@ -2758,15 +2748,22 @@ again:
   }
 
   /* After rendering we store the position of the last buffer so that we can use
-   * it to report the position. We need to take the lock here. */
+   * it to report the position. We need to take the lock here, and also get the
+   * sync property while we have it. */
   GST_OBJECT_LOCK (basesink);
   priv->current_sstart = sstart;
   priv->current_sstop = (GST_CLOCK_TIME_IS_VALID (sstop) ? sstop : sstart);
+  sync = basesink->sync;
   GST_OBJECT_UNLOCK (basesink);
 
   if (!do_sync)
     goto done;
 
+  /* without sync and rate control, waiting for the clock would return
+   * immediately, skip the latency adjustment and the clock locking */
+  if (!sync && !priv->max_bitrate)
+    goto done;
+
   /* adjust for latency */
   stime = gst_base_sink_adjust_time (basesink, rstart);
 
@@ -3247,8 +3244,7 @@ gst_base_sink_flush_start (GstBaseSink * basesink, GstPad * pad)
     gst_element_set_start_time (GST_ELEMENT_CAST (basesink), 0);
     basesink->priv->have_latency = TRUE;
   }
-  gst_base_sink_set_last_buffer (basesink, NULL);
-  gst_base_sink_set_last_buffer_list (basesink, NULL);
+  gst_base_sink_set_last_buffer_and_list (basesink, NULL, NULL);
   GST_PAD_STREAM_UNLOCK (pad);
 }
 
@@ -3949,8 +3945,8 @@ again:
 
   if (!is_list) {
     /* For buffer lists do not set last buffer for now. */
-    gst_base_sink_set_last_buffer (basesink, GST_BUFFER_CAST (obj));
-    gst_base_sink_set_last_buffer_list (basesink, NULL);
+    gst_base_sink_set_last_buffer_and_list (basesink, GST_BUFFER_CAST (obj),
+        NULL);
 
     if (bclass->render)
       ret = bclass->render (basesink, GST_BUFFER_CAST (obj));
@@ -3966,8 +3962,7 @@ again:
       ret = bclass->render_list (basesink, buffer_list);
 
     /* Set the first buffer and buffer list to be included in last sample */
-    gst_base_sink_set_last_buffer (basesink, sync_buf);
-    gst_base_sink_set_last_buffer_list (basesink, buffer_list);
+    gst_base_sink_set_last_buffer_and_list (basesink, sync_buf, buffer_list);
 
     /* Not currently supported */
     g_assert (ret != GST_BASE_SINK_FLOW_DROPPED);
@@ -4433,8 +4428,7 @@ gst_base_sink_perform_step (GstBaseSink * sink, GstPad * pad, GstEvent * event)
     priv->current_sstop = GST_CLOCK_TIME_NONE;
     priv->eos_rtime = GST_CLOCK_TIME_NONE;
     priv->call_preroll = TRUE;
-    gst_base_sink_set_last_buffer (sink, NULL);
-    gst_base_sink_set_last_buffer_list (sink, NULL);
+    gst_base_sink_set_last_buffer_and_list (sink, NULL, NULL);
     gst_base_sink_reset_qos (sink);
 
     if (sink->clock_id) {
@@ -5855,8 +5849,7 @@ gst_base_sink_change_state (GstElement * element, GstStateChange transition)
       gst_caps_replace (&basesink->priv->caps, NULL);
       GST_OBJECT_UNLOCK (basesink);
 
-      gst_base_sink_set_last_buffer (basesink, NULL);
-      gst_base_sink_set_last_buffer_list (basesink, NULL);
+      gst_base_sink_set_last_buffer_and_list (basesink, NULL, NULL);
       priv->call_preroll = FALSE;
 
       if (!priv->committed) {
@@ -5883,8 +5876,7 @@ gst_base_sink_change_state (GstElement * element, GstStateChange transition)
           GST_WARNING_OBJECT (basesink, "failed to stop");
         }
       }
-      gst_base_sink_set_last_buffer (basesink, NULL);
-      gst_base_sink_set_last_buffer_list (basesink, NULL);
+      gst_base_sink_set_last_buffer_and_list (basesink, NULL, NULL);
       priv->call_preroll = FALSE;
       break;
     default:
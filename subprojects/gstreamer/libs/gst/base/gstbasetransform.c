@@ -197,6 +197,9 @@ struct _GstBaseTransformPrivate
 
   GstBufferPool *pool;
   gboolean pool_active;
+  /* pool negotiation was skipped because we were in passthrough or in-place
+   * mode, do it when we need to allocate output buffers */
+  gboolean pool_delayed;
   GstAllocator *allocator;
   GstAllocationParams params;
   GstQuery *query;
@@ -938,9 +941,12 @@ gst_base_transform_do_bufferpool (GstBaseTransform * trans, GstCaps * outcaps)
      * then we will proxy the downstream pool */
     GST_DEBUG_OBJECT (trans, "we're passthough, delay bufferpool");
     gst_base_transform_set_allocation (trans, NULL, NULL, NULL, NULL);
+    priv->pool_delayed = TRUE;
     return TRUE;
   }
 
+  priv->pool_delayed = FALSE;
+
   /* not passthrough, we need to allocate */
   /* find a pool for the negotiated caps now */
   GST_DEBUG_OBJECT (trans, "doing allocation query");
@@ -967,6 +973,7 @@ gst_base_transform_do_bufferpool (GstBaseTransform * trans, GstCaps * outcaps)
   if (priv->passthrough || priv->always_in_place) {
     GST_DEBUG_OBJECT (trans, "no doing passthrough, delay bufferpool");
     gst_base_transform_set_allocation (trans, NULL, NULL, NULL, NULL);
+    priv->pool_delayed = TRUE;
     gst_query_unref (query);
     return TRUE;
   }
@@ -1655,6 +1662,25 @@ default_prepare_output_buffer (GstBaseTransform * trans,
     goto done;
   }
 
+  /* the subclass left passthrough or in-place mode after negotiation, we did
+   * not query downstream for a pool then so do it now instead of allocating
+   * a new buffer for each input buffer below */
+  if (G_UNLIKELY (priv->pool_delayed) && !priv->always_in_place) {
+    priv->pool_delayed = FALSE;
+
+    /* srcpad might be flushing already if we're being shut down */
+    outcaps = gst_pad_get_current_caps (trans->srcpad);
+    if (outcaps == NULL)
+      return GST_FLOW_FLUSHING;
+
+    GST_DEBUG_OBJECT (trans, "left passthrough, doing delayed bufferpool");
+    res = gst_base_transform_do_bufferpool (trans, outcaps);
+    gst_caps_unref (outcaps);
+
+    if (!res)
+      GST_WARNING_OBJECT (trans, "delayed allocation failed");
+  }
+
   /* we can't reuse the input buffer */
   if (priv->pool) {
     if (!priv->pool_active) {
@@ -2506,6 +2532,7 @@ gst_base_transform_activate (GstBaseTransform * trans, gboolean active)
       result &= bclass->stop (trans);
 
     gst_base_transform_set_allocation (trans, NULL, NULL, NULL, NULL);
+    priv->pool_delayed = FALSE;
   }
 
   return result;
@@ -100,6 +100,11 @@ helper_find_peek (gpointer data, gint64 offset, guint size)
   if (size == 0)
     return NULL;
 
+  /* nothing can override a maximum probability suggestion anymore, let the
+   * typefinder bail out early instead of pulling more data */
+  if (helper->best_probability >= GST_TYPE_FIND_MAXIMUM)
+    return NULL;
+
   if (offset < 0) {
     if (helper->size == -1 || helper->size < -offset)
       return NULL;
@@ -122,7 +127,7 @@ helper_find_peek (gpointer data, gint64 offset, guint size)
        * at this point we save the current position and stop searching if
        * we're after the searched end offset */
       if (buf_offset <= offset) {
-        if ((offset + size) < (buf_offset + buf_size)) {
+        if ((offset + size) <= (buf_offset + buf_size)) {
           /* must already have been mapped before */
           return (guint8 *) bmp->map.data + (offset - buf_offset);
         }
@@ -253,51 +258,48 @@ static GList *
 prioritize_extension (GstObject * obj, GList * type_list,
     const gchar * extension)
 {
-  gint pos = 0;
-  GList *next, *l;
+  GList *head = NULL, *tail = NULL, *l, *next;
 
   if (!extension)
     return type_list;
 
   /* move the typefinders for the extension first in the list. The idea is that
    * when one of them returns MAX we don't need to search further as there is a
-   * very high chance we got the right type. */
+   * very high chance we got the right type. Both parts keep their rank order,
+   * and the list is split in a single pass. */
 
   GST_LOG_OBJECT (obj, "sorting typefind for extension %s to head", extension);
 
   for (l = type_list; l; l = next) {
     const gchar *const *ext;
     GstTypeFindFactory *factory;
+    gboolean found = FALSE;
 
     next = l->next;
+    l->prev = l->next = NULL;
 
     factory = GST_TYPE_FIND_FACTORY (l->data);
 
     ext = gst_type_find_factory_get_extensions (factory);
-    if (ext == NULL)
-      continue;
+    if (ext != NULL) {
+      GST_LOG_OBJECT (obj, "testing factory %s for extension %s",
+          GST_OBJECT_NAME (factory), extension);
 
-    GST_LOG_OBJECT (obj, "testing factory %s for extension %s",
-        GST_OBJECT_NAME (factory), extension);
+      for (; *ext != NULL && !found; ++ext)
+        found = strcmp (*ext, extension) == 0;
+    }
 
-    while (*ext != NULL) {
-      if (strcmp (*ext, extension) == 0) {
-        /* found extension, move in front */
-        GST_LOG_OBJECT (obj, "moving typefind for extension %s to head",
-            extension);
-        /* remove entry from list */
-        type_list = g_list_delete_link (type_list, l);
-        /* insert at the position */
-        type_list = g_list_insert (type_list, factory, pos);
-        /* next element will be inserted after this one */
-        pos++;
-        break;
-      }
-      ++ext;
+    if (found) {
+      GST_LOG_OBJECT (obj, "moving typefind for extension %s to head",
+          extension);
+      /* prepend and reverse later, to not walk the list for every match */
+      head = g_list_concat (l, head);
+    } else {
+      tail = g_list_concat (l, tail);
     }
   }
 
-  return type_list;
+  return g_list_concat (g_list_reverse (head), g_list_reverse (tail));
 }
 
 /**
@@ -535,6 +537,10 @@ buf_helper_find_peek (gpointer data, gint64 off, guint size)
   if (size == 0)
     return NULL;
 
+  /* see helper_find_peek() */
+  if (helper->best_probability >= GST_TYPE_FIND_MAXIMUM)
+    return NULL;
+
   if (off < 0) {
     GST_LOG_OBJECT (helper->obj,
         "Typefind factory wanted to peek at end; not supported");
@@ -563,11 +563,6 @@ gst_writev_buffer_list (GstObject * sink, gint fd, GstPoll * fdset,
       break;
     }
 
-    if (flow_ret != GST_FLOW_OK) {
-      g_assert (bytes_written_local == 0);
-      break;
-    }
-
     if (bytes_written)
       *bytes_written += bytes_written_local;
 
@@ -587,25 +582,29 @@ gst_writev_buffer_list (GstObject * sink, gint fd, GstPoll * fdset,
     if (bytes_written_local > 0) {
       vecs[vecs_written].iov_len -= bytes_written_local;
       vecs[vecs_written].iov_base =
-          ((guint8 *) vecs[0].iov_base) + bytes_written_local;
+          ((guint8 *) vecs[vecs_written].iov_base) + bytes_written_local;
       left -= bytes_written_local;
     }
 
-    /* If we have buffers left, fill them in now */
-    if (current_buf_idx < num_bufs) {
-      GstBuffer *buf;
-      GstMemory *mem;
-      guint j = current_buf_mem_idx;
-
-      /* Unmap the first vecs_written memories now */
+    /* Unmap the first vecs_written memories now and move the remaining
+     * vecs and maps back to the beginning, also when there is nothing left
+     * to refill as the next write has to start at the first unwritten
+     * vector */
+    if (vecs_written > 0) {
       for (i = 0; i < vecs_written; i++)
         gst_memory_unmap (maps[i].memory, &maps[i]);
-      /* Move upper remaining vecs and maps back to the beginning */
       memmove (vecs, &vecs[vecs_written],
           (num_vecs - vecs_written) * sizeof (vecs[0]));
       memmove (maps, &maps[vecs_written],
           (num_vecs - vecs_written) * sizeof (maps[0]));
       num_vecs -= vecs_written;
+    }
+
+    /* If we have buffers left, fill them in now */
+    if (current_buf_idx < num_bufs) {
+      GstBuffer *buf;
+      GstMemory *mem;
+      guint j = current_buf_mem_idx;
 
       /* And finally refill */
       for (i = current_buf_idx; i < num_bufs && num_vecs < GST_IOV_MAX; i++) {
@@ -71,6 +71,7 @@ enum
 #define DEFAULT_CAN_ACTIVATE_PUSH TRUE
 #define DEFAULT_CAN_ACTIVATE_PULL FALSE
 #define DEFAULT_NUM_BUFFERS -1
+#define DEFAULT_ENABLE_TIMING_STATS FALSE
 
 enum
 {
@@ -83,7 +84,9 @@ enum
   PROP_LAST_MESSAGE,
   PROP_CAN_ACTIVATE_PUSH,
   PROP_CAN_ACTIVATE_PULL,
-  PROP_NUM_BUFFERS
+  PROP_NUM_BUFFERS,
+  PROP_ENABLE_TIMING_STATS,
+  PROP_TIMING_STATS
 };
 
 #define GST_TYPE_FAKE_SINK_STATE_ERROR (gst_fake_sink_state_error_get_type())
@@ -200,6 +203,58 @@ gst_fake_sink_class_init (GstFakeSinkClass * klass)
           "Number of buffers to accept going EOS", -1, G_MAXINT,
           DEFAULT_NUM_BUFFERS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstFakeSink:enable-timing-stats:
+   *
+   * Collect the arrival time and processing latency of each rendered buffer
+   * to provide the #GstFakeSink:timing-stats. Useful to measure the
+   * throughput and latency of a pipeline.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_ENABLE_TIMING_STATS,
+      g_param_spec_boolean ("enable-timing-stats", "Enable timing stats",
+          "Collect buffer arrival and latency timing statistics",
+          DEFAULT_ENABLE_TIMING_STATS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstFakeSink:timing-stats:
+   *
+   * Timing statistics of the rendered buffers since the last READY to PAUSED
+   * state change, collected when #GstFakeSink:enable-timing-stats is set.
+   * This property returns a #GstStructure named
+   * application/x-fakesink-timing-stats with the following fields:
+   *
+   * - #guint64 `num-buffers`: the number of rendered buffers.
+   * - #guint64 `num-bytes`: the number of rendered bytes.
+   * - #guint64 `elapsed`: the time between the first and the last buffer,
+   *   in nanoseconds.
+   * - #guint64 `min-interval`, `max-interval` and `average-interval`: the
+   *   time between two consecutive buffers, in nanoseconds.
+   * - #gdouble `buffers-per-second` and `bytes-per-second`: the throughput.
+   * - #GstValueArray of #guint64 `interval-histogram`: the number of
+   *   intervals below 1 microsecond in the first entry, and between 2^(n-1)
+   *   and 2^n microseconds in entry n.
+   * - #guint64 `num-latencies`: the number of buffers with a processing
+   *   latency. The processing latency is the time between the running time
+   *   of a buffer and the clock running time when it is rendered, it is only
+   *   measured for timestamped buffers in TIME segments while a clock is
+   *   available. With #GstBaseSink:sync enabled it only contains the
+   *   synchronisation jitter.
+   * - #guint64 `min-latency`, `max-latency` and `average-latency`: the
+   *   processing latency, in nanoseconds.
+   * - #GstValueArray of #guint64 `latency-histogram`: the distribution of
+   *   the processing latencies, using the same buckets as
+   *   `interval-histogram`.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_TIMING_STATS,
+      g_param_spec_boxed ("timing-stats", "Timing statistics",
+          "Buffer arrival and latency timing statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstFakeSink::handoff:
    * @fakesink: the fakesink instance
@@ -258,6 +313,7 @@ gst_fake_sink_init (GstFakeSink * fakesink)
   fakesink->state_error = DEFAULT_STATE_ERROR;
   fakesink->signal_handoffs = DEFAULT_SIGNAL_HANDOFFS;
   fakesink->num_buffers = DEFAULT_NUM_BUFFERS;
+  fakesink->enable_timing_stats = DEFAULT_ENABLE_TIMING_STATS;
 
   gst_base_sink_set_sync (GST_BASE_SINK (fakesink), DEFAULT_SYNC);
   gst_base_sink_set_drop_out_of_segment (GST_BASE_SINK (fakesink),
@@ -304,12 +360,193 @@ gst_fake_sink_set_property (GObject * object, guint prop_id,
     case PROP_NUM_BUFFERS:
       sink->num_buffers = g_value_get_int (value);
       break;
+    case PROP_ENABLE_TIMING_STATS:
+      GST_OBJECT_LOCK (sink);
+      sink->enable_timing_stats = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (sink);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static void
+gst_fake_sink_reset_timing_stats (GstFakeSink * sink)
+{
+  GST_OBJECT_LOCK (sink);
+  sink->stats_buffers = 0;
+  sink->stats_bytes = 0;
+  sink->stats_first = GST_CLOCK_TIME_NONE;
+  sink->stats_last = GST_CLOCK_TIME_NONE;
+  sink->stats_min_interval = GST_CLOCK_TIME_NONE;
+  sink->stats_max_interval = 0;
+  memset (sink->stats_interval_histogram, 0,
+      sizeof (sink->stats_interval_histogram));
+  sink->stats_latencies = 0;
+  sink->stats_total_latency = 0;
+  sink->stats_min_latency = GST_CLOCK_TIME_NONE;
+  sink->stats_max_latency = 0;
+  memset (sink->stats_latency_histogram, 0,
+      sizeof (sink->stats_latency_histogram));
+  GST_OBJECT_UNLOCK (sink);
+}
+
+/* power-of-two microsecond buckets, see the timing-stats documentation */
+static guint
+gst_fake_sink_histogram_bucket (GstClockTime time)
+{
+  guint bucket;
+
+  if (time < GST_USECOND)
+    return 0;
+
+  bucket = g_bit_storage (time / GST_USECOND);
+
+  return MIN (bucket, GST_FAKE_SINK_HISTOGRAM_SIZE - 1);
+}
+
+/* time between the running time of @buf and the clock running time now, or
+ * GST_CLOCK_TIME_NONE if that can't be known */
+static GstClockTime
+gst_fake_sink_get_processing_latency (GstFakeSink * sink, GstBuffer * buf)
+{
+  GstBaseSink *bsink = GST_BASE_SINK_CAST (sink);
+  GstClockTime timestamp, running_time, base_time, now;
+  GstClock *clock;
+
+  if (bsink->segment.format != GST_FORMAT_TIME)
+    return GST_CLOCK_TIME_NONE;
+
+  timestamp = GST_BUFFER_PTS (buf);
+  if (!GST_CLOCK_TIME_IS_VALID (timestamp))
+    timestamp = GST_BUFFER_DTS (buf);
+  if (!GST_CLOCK_TIME_IS_VALID (timestamp))
+    return GST_CLOCK_TIME_NONE;
+
+  running_time = gst_segment_to_running_time (&bsink->segment,
+      GST_FORMAT_TIME, timestamp);
+  if (!GST_CLOCK_TIME_IS_VALID (running_time))
+    return GST_CLOCK_TIME_NONE;
+
+  GST_OBJECT_LOCK (sink);
+  if ((clock = GST_ELEMENT_CLOCK (sink)))
+    gst_object_ref (clock);
+  base_time = GST_ELEMENT_CAST (sink)->base_time;
+  GST_OBJECT_UNLOCK (sink);
+
+  if (clock == NULL)
+    return GST_CLOCK_TIME_NONE;
+
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+
+  /* early buffers have no latency */
+  if (now < base_time || now - base_time < running_time)
+    return 0;
+
+  return now - base_time - running_time;
+}
+
+/* WITH OBJECT LOCK */
+static void
+gst_fake_sink_update_timing_stats (GstFakeSink * sink, GstBuffer * buf,
+    GstClockTime latency)
+{
+  GstClockTime now = gst_util_get_timestamp ();
+
+  if (GST_CLOCK_TIME_IS_VALID (sink->stats_last)) {
+    GstClockTime interval = now - sink->stats_last;
+
+    if (interval < sink->stats_min_interval
+        || !GST_CLOCK_TIME_IS_VALID (sink->stats_min_interval))
+      sink->stats_min_interval = interval;
+    if (interval > sink->stats_max_interval)
+      sink->stats_max_interval = interval;
+
+    sink->stats_interval_histogram[gst_fake_sink_histogram_bucket
+        (interval)]++;
+  } else {
+    sink->stats_first = now;
+  }
+
+  if (GST_CLOCK_TIME_IS_VALID (latency)) {
+    if (latency < sink->stats_min_latency
+        || !GST_CLOCK_TIME_IS_VALID (sink->stats_min_latency))
+      sink->stats_min_latency = latency;
+    if (latency > sink->stats_max_latency)
+      sink->stats_max_latency = latency;
+    sink->stats_latencies++;
+    sink->stats_total_latency += latency;
+    sink->stats_latency_histogram[gst_fake_sink_histogram_bucket
+        (latency)]++;
+  }
+
+  sink->stats_last = now;
+  sink->stats_buffers++;
+  sink->stats_bytes += gst_buffer_get_size (buf);
+}
+
+static GstStructure *
+gst_fake_sink_create_timing_stats (GstFakeSink * sink)
+{
+  GstStructure *s;
+  GValue intervals = G_VALUE_INIT;
+  GValue latencies = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  GstClockTime elapsed = 0, min_interval = 0, avg_interval = 0;
+  GstClockTime min_latency = 0, avg_latency = 0;
+  gdouble buffers_per_second = 0.0, bytes_per_second = 0.0;
+  guint i;
+
+  gst_value_array_init (&intervals, GST_FAKE_SINK_HISTOGRAM_SIZE);
+  gst_value_array_init (&latencies, GST_FAKE_SINK_HISTOGRAM_SIZE);
+  g_value_init (&v, G_TYPE_UINT64);
+
+  GST_OBJECT_LOCK (sink);
+  if (sink->stats_buffers > 1) {
+    elapsed = sink->stats_last - sink->stats_first;
+    min_interval = sink->stats_min_interval;
+    avg_interval = elapsed / (sink->stats_buffers - 1);
+    if (elapsed > 0) {
+      buffers_per_second =
+          (gdouble) (sink->stats_buffers - 1) * GST_SECOND / elapsed;
+      bytes_per_second = (gdouble) sink->stats_bytes * GST_SECOND / elapsed;
+    }
+  }
+  if (sink->stats_latencies > 0) {
+    min_latency = sink->stats_min_latency;
+    avg_latency = sink->stats_total_latency / sink->stats_latencies;
+  }
+  for (i = 0; i < GST_FAKE_SINK_HISTOGRAM_SIZE; i++) {
+    g_value_set_uint64 (&v, sink->stats_interval_histogram[i]);
+    gst_value_array_append_value (&intervals, &v);
+    g_value_set_uint64 (&v, sink->stats_latency_histogram[i]);
+    gst_value_array_append_value (&latencies, &v);
+  }
+
+  s = gst_structure_new ("application/x-fakesink-timing-stats",
+      "num-buffers", G_TYPE_UINT64, sink->stats_buffers,
+      "num-bytes", G_TYPE_UINT64, sink->stats_bytes,
+      "elapsed", G_TYPE_UINT64, elapsed,
+      "min-interval", G_TYPE_UINT64, min_interval,
+      "max-interval", G_TYPE_UINT64, sink->stats_max_interval,
+      "average-interval", G_TYPE_UINT64, avg_interval,
+      "buffers-per-second", G_TYPE_DOUBLE, buffers_per_second,
+      "bytes-per-second", G_TYPE_DOUBLE, bytes_per_second,
+      "num-latencies", G_TYPE_UINT64, sink->stats_latencies,
+      "min-latency", G_TYPE_UINT64, min_latency,
+      "max-latency", G_TYPE_UINT64, sink->stats_max_latency,
+      "average-latency", G_TYPE_UINT64, avg_latency, NULL);
+  GST_OBJECT_UNLOCK (sink);
+
+  gst_structure_take_value (s, "interval-histogram", &intervals);
+  gst_structure_take_value (s, "latency-histogram", &latencies);
+  g_value_unset (&v);
+
+  return s;
+}
+
 static void
 gst_fake_sink_get_property (GObject * object, guint prop_id, GValue * value,
     GParamSpec * pspec)
@@ -349,6 +586,14 @@ gst_fake_sink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_NUM_BUFFERS:
       g_value_set_int (value, sink->num_buffers);
       break;
+    case PROP_ENABLE_TIMING_STATS:
+      GST_OBJECT_LOCK (sink);
+      g_value_set_boolean (value, sink->enable_timing_stats);
+      GST_OBJECT_UNLOCK (sink);
+      break;
+    case PROP_TIMING_STATS:
+      g_value_take_boxed (value, gst_fake_sink_create_timing_stats (sink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -452,6 +697,14 @@ gst_fake_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   if (sink->num_buffers_left != -1)
     sink->num_buffers_left--;
 
+  if (G_UNLIKELY (sink->enable_timing_stats)) {
+    GstClockTime latency = gst_fake_sink_get_processing_latency (sink, buf);
+
+    GST_OBJECT_LOCK (sink);
+    gst_fake_sink_update_timing_stats (sink, buf, latency);
+    GST_OBJECT_UNLOCK (sink);
+  }
+
   if (!sink->silent) {
     gchar dts_str[64], pts_str[64], dur_str[64];
     gchar *flag_str, *meta_str;
@@ -561,6 +814,7 @@ gst_fake_sink_change_state (GstElement * element, GstStateChange transition)
       if (fakesink->state_error == FAKE_SINK_STATE_ERROR_READY_PAUSED)
         goto error;
       fakesink->num_buffers_left = fakesink->num_buffers;
+      gst_fake_sink_reset_timing_stats (fakesink);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
       if (fakesink->state_error == FAKE_SINK_STATE_ERROR_PAUSED_PLAYING)
@@ -67,6 +67,9 @@ typedef enum {
 typedef struct _GstFakeSink GstFakeSink;
 typedef struct _GstFakeSinkClass GstFakeSinkClass;
 
+/* number of power-of-two buckets in the interval and latency histograms */
+#define GST_FAKE_SINK_HISTOGRAM_SIZE 32
+
 /**
  * GstFakeSink:
  *
@@ -82,6 +85,21 @@ struct _GstFakeSink {
   gchar			*last_message;
   gint                  num_buffers;
   gint                  num_buffers_left;
+
+  /* timing statistics, protected with the object lock */
+  gboolean              enable_timing_stats;
+  guint64               stats_buffers;
+  guint64               stats_bytes;
+  GstClockTime          stats_first;
+  GstClockTime          stats_last;
+  GstClockTime          stats_min_interval;
+  GstClockTime          stats_max_interval;
+  guint64               stats_interval_histogram[GST_FAKE_SINK_HISTOGRAM_SIZE];
+  guint64               stats_latencies;
+  GstClockTime          stats_total_latency;
+  GstClockTime          stats_min_latency;
+  GstClockTime          stats_max_latency;
+  guint64               stats_latency_histogram[GST_FAKE_SINK_HISTOGRAM_SIZE];
 };
 
 struct _GstFakeSinkClass {
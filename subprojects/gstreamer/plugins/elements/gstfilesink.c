@@ -846,6 +846,32 @@ gst_file_sink_flush_buffer (GstFileSink * filesink)
   return flow_ret;
 }
 
+/* commit written data to storage, for buffers with the SYNC_AFTER flag.
+ * Only the data and the metadata needed to read it back (i.e. the file size)
+ * need to be committed, so avoid the extra inode update of fsync() */
+static GstFlowReturn
+gst_file_sink_sync (GstFileSink * filesink)
+{
+  gint fsync_ret;
+
+  do {
+#ifdef HAVE_FDATASYNC
+    fsync_ret = fdatasync (fileno (filesink->file));
+#else
+    fsync_ret = fsync (fileno (filesink->file));
+#endif
+  } while (fsync_ret < 0 && errno == EINTR);
+
+  if (fsync_ret) {
+    GST_ELEMENT_ERROR (filesink, RESOURCE, WRITE,
+        (_("Error while writing to file \"%s\"."), filesink->filename),
+        ("%s", g_strerror (errno)));
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
 static gboolean
 has_sync_after_buffer (GstBuffer ** buffer, guint idx, gpointer user_data)
 {
@@ -905,7 +931,6 @@ gst_file_sink_render_list (GstBaseSink * bsink, GstBufferList * buffer_list)
   GstFileSink *sink;
   guint i, num_buffers;
   gboolean sync_after = FALSE;
-  gint fsync_ret;
 
   sink = GST_FILE_SINK_CAST (bsink);
 
@@ -968,17 +993,8 @@ gst_file_sink_render_list (GstBaseSink * bsink, GstBufferList * buffer_list)
     }
   }
 
-  if (flow == GST_FLOW_OK && sync_after) {
-    do {
-      fsync_ret = fsync (fileno (sink->file));
-    } while (fsync_ret < 0 && errno == EINTR);
-    if (fsync_ret) {
-      GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
-          (_("Error while writing to file \"%s\"."), sink->filename),
-          ("%s", g_strerror (errno)));
-      flow = GST_FLOW_ERROR;
-    }
-  }
+  if (flow == GST_FLOW_OK && sync_after)
+    flow = gst_file_sink_sync (sink);
 
   return flow;
 
@@ -996,7 +1012,6 @@ gst_file_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   GstFlowReturn flow;
   guint8 n_mem;
   gboolean sync_after;
-  gint fsync_ret;
 
   filesink = GST_FILE_SINK_CAST (sink);
 
@@ -1052,17 +1067,8 @@ gst_file_sink_render (GstBaseSink * sink, GstBuffer * buffer)
     flow = GST_FLOW_OK;
   }
 
-  if (flow == GST_FLOW_OK && sync_after) {
-    do {
-      fsync_ret = fsync (fileno (filesink->file));
-    } while (fsync_ret < 0 && errno == EINTR);
-    if (fsync_ret) {
-      GST_ELEMENT_ERROR (filesink, RESOURCE, WRITE,
-          (_("Error while writing to file \"%s\"."), filesink->filename),
-          ("%s", g_strerror (errno)));
-      flow = GST_FLOW_ERROR;
-    }
-  }
+  if (flow == GST_FLOW_OK && sync_after)
+    flow = gst_file_sink_sync (filesink);
 
   return flow;
 }
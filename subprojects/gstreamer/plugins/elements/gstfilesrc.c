@@ -31,6 +31,10 @@
  * gst-launch-1.0 filesrc location=song.ogg ! decodebin ! audioconvert ! audioresample ! autoaudiosink
  * ]| Play song.ogg audio file which must be in the current working directory.
  *
+ * When #GstFileSrc:use-mmap is enabled, buffers for regular files directly
+ * reference a read-only memory mapping of the file instead of containing a
+ * copy of the data.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -68,6 +72,10 @@
 #  include <unistd.h>
 #endif
 
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#endif
+
 #define struct_stat struct stat
 
 #ifdef __BIONIC__               /* Android */
@@ -113,11 +121,27 @@ enum
 };
 
 #define DEFAULT_BLOCKSIZE       4*1024
+#define DEFAULT_USE_MMAP        FALSE
+
+/* how much to ask the kernel to page in ahead of the read position when
+ * reading from a mapping */
+#define MMAP_READ_AHEAD         (2 * 1024 * 1024)
 
 enum
 {
   PROP_0,
-  PROP_LOCATION
+  PROP_LOCATION,
+  PROP_USE_MMAP
+};
+
+/* Shared between the element and all buffers that reference the mapping, so
+ * that buffers can outlive the element being stopped */
+struct _GstFileSrcMapping
+{
+  gint refcount;
+  guint8 *data;
+  gsize size;
+  gsize page_size;
 };
 
 static void gst_file_src_finalize (GObject * object);
@@ -134,6 +158,8 @@ static gboolean gst_file_src_is_seekable (GstBaseSrc * src);
 static gboolean gst_file_src_get_size (GstBaseSrc * src, guint64 * size);
 static GstFlowReturn gst_file_src_fill (GstBaseSrc * src, guint64 offset,
     guint length, GstBuffer * buf);
+static GstFlowReturn gst_file_src_create (GstBaseSrc * src, guint64 offset,
+    guint length, GstBuffer ** buf);
 
 static void gst_file_src_uri_handler_init (gpointer g_iface,
     gpointer iface_data);
@@ -166,6 +192,27 @@ gst_file_src_class_init (GstFileSrcClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  /**
+   * GstFileSrc:use-mmap:
+   *
+   * Map regular files into memory and output buffers referencing the mapping
+   * instead of reading the data into newly allocated buffers. This avoids a
+   * copy per read, e.g. for demuxers operating in pull mode.
+   *
+   * Reads beyond the size of the file at the time it was opened fall back to
+   * normal reads, as do all reads after the file was found to be truncated.
+   * Note that truncating the file while buffers referencing the mapping are
+   * still in use will crash the application, so this should only be used for
+   * files that are not modified while being read.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "Map the file into memory instead of reading it", DEFAULT_USE_MMAP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gobject_class->finalize = gst_file_src_finalize;
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -180,6 +227,7 @@ gst_file_src_class_init (GstFileSrcClass * klass)
   gstbasesrc_class->is_seekable = GST_DEBUG_FUNCPTR (gst_file_src_is_seekable);
   gstbasesrc_class->get_size = GST_DEBUG_FUNCPTR (gst_file_src_get_size);
   gstbasesrc_class->fill = GST_DEBUG_FUNCPTR (gst_file_src_fill);
+  gstbasesrc_class->create = GST_DEBUG_FUNCPTR (gst_file_src_create);
 
   if (sizeof (off_t) < 8) {
     GST_LOG ("No large file support, sizeof (off_t) = %" G_GSIZE_FORMAT "!",
@@ -195,6 +243,8 @@ gst_file_src_init (GstFileSrc * src)
   src->uri = NULL;
 
   src->is_regular = FALSE;
+  src->use_mmap = DEFAULT_USE_MMAP;
+  src->mapping = NULL;
 
   gst_base_src_set_blocksize (GST_BASE_SRC (src), DEFAULT_BLOCKSIZE);
 }
@@ -273,6 +323,9 @@ gst_file_src_set_property (GObject * object, guint prop_id,
     case PROP_LOCATION:
       gst_file_src_set_location (src, g_value_get_string (value), NULL);
       break;
+    case PROP_USE_MMAP:
+      src->use_mmap = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -293,6 +346,9 @@ gst_file_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_LOCATION:
       g_value_set_string (value, src->filename);
       break;
+    case PROP_USE_MMAP:
+      g_value_set_boolean (value, src->use_mmap);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -318,9 +374,20 @@ gst_file_src_fill (GstBaseSrc * basesrc, guint64 offset, guint length,
   int ret;
   GstMapInfo info;
   guint8 *data;
+#ifdef HAVE_PREAD
+  gboolean positioned;
+#endif
 
   src = GST_FILE_SRC_CAST (basesrc);
 
+#ifdef HAVE_PREAD
+  /* for random access on regular files (demuxers in pull mode), read at the
+   * requested offset directly instead of doing an lseek() first */
+  positioned = src->seekable && offset != -1;
+  if (positioned)
+    src->read_position = offset;
+#endif
+
   if (G_UNLIKELY (offset != -1 && src->read_position != offset)) {
     off_t res;
 
@@ -341,7 +408,12 @@ gst_file_src_fill (GstBaseSrc * basesrc, guint64 offset, guint length,
     GST_LOG_OBJECT (src, "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x",
         to_read, offset + bytes_read);
     errno = 0;
-    ret = read (src->fd, data + bytes_read, to_read);
+#ifdef HAVE_PREAD
+    if (positioned)
+      ret = pread (src->fd, data + bytes_read, to_read, offset + bytes_read);
+    else
+#endif
+      ret = read (src->fd, data + bytes_read, to_read);
     if (G_UNLIKELY (ret < 0)) {
       if (errno == EAGAIN || errno == EINTR)
         continue;
@@ -398,6 +470,105 @@ buffer_write_fail:
   }
 }
 
+#ifdef HAVE_SYS_MMAN_H
+static GstFileSrcMapping *
+gst_file_src_mapping_new (GstFileSrc * src, gsize size)
+{
+  GstFileSrcMapping *mapping;
+  gpointer data;
+
+  data = mmap (NULL, size, PROT_READ, MAP_SHARED, src->fd, 0);
+  if (data == MAP_FAILED) {
+    GST_WARNING_OBJECT (src, "mmap failed, reading normally: %s",
+        g_strerror (errno));
+    return NULL;
+  }
+
+  mapping = g_new0 (GstFileSrcMapping, 1);
+  mapping->refcount = 1;
+  mapping->data = data;
+  mapping->size = size;
+  mapping->page_size = sysconf (_SC_PAGESIZE);
+
+  GST_DEBUG_OBJECT (src, "mapped %" G_GSIZE_FORMAT " bytes at %p", size, data);
+
+  return mapping;
+}
+
+static GstFileSrcMapping *
+gst_file_src_mapping_ref (GstFileSrcMapping * mapping)
+{
+  g_atomic_int_inc (&mapping->refcount);
+
+  return mapping;
+}
+
+static void
+gst_file_src_mapping_unref (GstFileSrcMapping * mapping)
+{
+  if (g_atomic_int_dec_and_test (&mapping->refcount)) {
+    munmap (mapping->data, mapping->size);
+    g_free (mapping);
+  }
+}
+#endif
+
+static GstFlowReturn
+gst_file_src_create (GstBaseSrc * basesrc, guint64 offset, guint length,
+    GstBuffer ** buffer)
+{
+#ifdef HAVE_SYS_MMAN_H
+  GstFileSrc *src = GST_FILE_SRC_CAST (basesrc);
+  GstFileSrcMapping *mapping = src->mapping;
+
+  /* only when we can produce the buffer ourselves and the range is inside
+   * the mapping, otherwise let the default implementation read the data */
+  if (mapping != NULL && *buffer == NULL && offset != -1 && length > 0 &&
+      offset < mapping->size && length <= mapping->size - offset) {
+    GstBuffer *buf;
+    gsize ahead_start, ahead_end;
+    struct_stat stat_results;
+
+    /* accessing pages of the mapping beyond the end of a truncated file
+     * raises SIGBUS, stop using the mapping and read normally instead */
+    if (fstat (src->fd, &stat_results) < 0
+        || (guint64) stat_results.st_size < offset + length) {
+      GST_WARNING_OBJECT (src, "file was truncated, not using mmap anymore");
+      src->mapping = NULL;
+      gst_file_src_mapping_unref (mapping);
+      goto read;
+    }
+
+    GST_LOG_OBJECT (src, "Mapping %u bytes at offset 0x%" G_GINT64_MODIFIER
+        "x", length, offset);
+
+    buf = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
+        mapping->data + offset, length, 0, length,
+        gst_file_src_mapping_ref (mapping),
+        (GDestroyNotify) gst_file_src_mapping_unref);
+
+    GST_BUFFER_OFFSET (buf) = offset;
+    GST_BUFFER_OFFSET_END (buf) = offset + length;
+
+    /* prefetch what will likely be read next */
+    ahead_start = (offset + length) & ~(mapping->page_size - 1);
+    ahead_end = MIN (offset + length + MMAP_READ_AHEAD,
+        MIN (mapping->size, (gsize) stat_results.st_size));
+    if (ahead_start < ahead_end)
+      madvise (mapping->data + ahead_start, ahead_end - ahead_start,
+          MADV_WILLNEED);
+
+    *buffer = buf;
+
+    return GST_FLOW_OK;
+  }
+
+read:
+#endif
+  return GST_BASE_SRC_CLASS (parent_class)->create (basesrc, offset, length,
+      buffer);
+}
+
 static gboolean
 gst_file_src_is_seekable (GstBaseSrc * basesrc)
 {
@@ -567,6 +738,22 @@ gst_file_src_start (GstBaseSrc * basesrc)
    * don't know their length, so seeking isn't useful/meaningful */
   src->seekable = src->seekable && src->is_regular;
 
+#ifdef HAVE_POSIX_FADVISE
+  /* most reads are linear, let the kernel read ahead more aggressively */
+  if (src->is_regular)
+    posix_fadvise (src->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+  if (src->use_mmap && src->seekable) {
+    guint64 size;
+
+    if (gst_file_src_get_size (basesrc, &size) && size > 0
+        && size <= G_MAXSIZE)
+      src->mapping = gst_file_src_mapping_new (src, size);
+  }
+#endif
+
   gst_base_src_set_dynamic_size (basesrc, src->seekable);
 
   return TRUE;
@@ -632,6 +819,14 @@ gst_file_src_stop (GstBaseSrc * basesrc)
 {
   GstFileSrc *src = GST_FILE_SRC (basesrc);
 
+#ifdef HAVE_SYS_MMAN_H
+  /* buffers still in flight keep the mapping alive */
+  if (src->mapping) {
+    gst_file_src_mapping_unref (src->mapping);
+    src->mapping = NULL;
+  }
+#endif
+
   /* close the file */
   g_close (src->fd, NULL);
 
@@ -45,6 +45,7 @@ G_BEGIN_DECLS
 
 typedef struct _GstFileSrc GstFileSrc;
 typedef struct _GstFileSrcClass GstFileSrcClass;
+typedef struct _GstFileSrcMapping GstFileSrcMapping;
 
 /**
  * GstFileSrc:
@@ -63,6 +64,9 @@ struct _GstFileSrc {
   gboolean seekable;                    /* whether the file is seekable */
   gboolean is_regular;                  /* whether it's a (symlink to a)
                                            regular file */
+
+  gboolean use_mmap;                    /* map the file instead of reading */
+  GstFileSrcMapping *mapping;           /* mapping of the file, if any */
 };
 
 struct _GstFileSrcClass {
@@ -199,6 +199,8 @@ static GstIterator *gst_selector_pad_iterate_linked_pads (GstPad * pad,
     GstObject * parent);
 static GstFlowReturn gst_selector_pad_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buf);
+static GstFlowReturn gst_selector_pad_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static void gst_selector_pad_cache_buffer (GstSelectorPad * selpad,
     GstBuffer * buffer);
 static void gst_selector_pad_free_cached_buffers (GstSelectorPad * selpad);
@@ -1277,6 +1279,85 @@ flushing:
   }
 }
 
+/* Buffer lists on the active pad are forwarded intact when no per-buffer
+ * handling is needed, everything else goes through the chain function for
+ * each buffer */
+static GstFlowReturn
+gst_selector_pad_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstInputSelector *sel;
+  GstSelectorPad *selpad;
+  GstFlowReturn res = GST_FLOW_OK;
+  GstBuffer *buf;
+  GstClockTime running_time = GST_CLOCK_TIME_NONE;
+  guint i, len;
+
+  sel = GST_INPUT_SELECTOR (parent);
+  selpad = GST_SELECTOR_PAD_CAST (pad);
+
+  len = gst_buffer_list_length (list);
+  if (len == 0)
+    goto done;
+
+  GST_INPUT_SELECTOR_LOCK (sel);
+  /* pad switches, pending sticky events, discont marking and buffer caching
+   * are all handled per buffer */
+  if (sel->flushing || sel->active_sinkpad != pad || selpad->events_pending
+      || selpad->discont || (sel->sync_streams && sel->cache_buffers)) {
+    GST_INPUT_SELECTOR_UNLOCK (sel);
+    goto slow_path;
+  }
+
+  /* update the segment on the srcpad with the last timestamp */
+  for (i = len; i > 0; i--) {
+    buf = gst_buffer_list_get (list, i - 1);
+    if (GST_BUFFER_PTS_IS_VALID (buf)) {
+      GST_OBJECT_LOCK (pad);
+      selpad->segment.position = GST_BUFFER_PTS (buf);
+      GST_OBJECT_UNLOCK (pad);
+      break;
+    }
+  }
+
+  /* Tell all non-active pads that we advanced the running time */
+  if (sel->sync_streams)
+    GST_INPUT_SELECTOR_BROADCAST (sel);
+
+  GST_INPUT_SELECTOR_UNLOCK (sel);
+
+  buf = gst_buffer_list_get (list, len - 1);
+  if (selpad->segment.format == GST_FORMAT_TIME)
+    running_time =
+        gst_segment_to_running_time (&selpad->segment, GST_FORMAT_TIME,
+        GST_BUFFER_DTS_OR_PTS (buf));
+
+  GST_LOG_OBJECT (pad, "Forwarding list %p of %u buffers", list, len);
+  sel->last_output_ts = running_time;
+
+  res = gst_pad_push_list (sel->srcpad, list);
+  GST_LOG_OBJECT (pad, "List %p forwarded result=%d", list, res);
+
+  GST_INPUT_SELECTOR_LOCK (sel);
+  selpad->pushed = TRUE;
+  GST_INPUT_SELECTOR_UNLOCK (sel);
+
+  return res;
+
+slow_path:
+  for (i = 0; i < len; i++) {
+    buf = gst_buffer_ref (gst_buffer_list_get (list, i));
+    res = gst_selector_pad_chain (pad, parent, buf);
+    if (res != GST_FLOW_OK)
+      break;
+  }
+
+done:
+  gst_buffer_list_unref (list);
+
+  return res;
+}
+
 static void gst_input_selector_dispose (GObject * object);
 static void gst_input_selector_finalize (GObject * object);
 
@@ -1937,6 +2018,8 @@ gst_input_selector_request_new_pad (GstElement * element,
       GST_DEBUG_FUNCPTR (gst_selector_pad_query));
   gst_pad_set_chain_function (sinkpad,
       GST_DEBUG_FUNCPTR (gst_selector_pad_chain));
+  gst_pad_set_chain_list_function (sinkpad,
+      GST_DEBUG_FUNCPTR (gst_selector_pad_chain_list));
   gst_pad_set_iterate_internal_links_function (sinkpad,
       GST_DEBUG_FUNCPTR (gst_selector_pad_iterate_linked_pads));
 
@@ -1496,10 +1496,13 @@ update_buffering (GstMultiQueue * mq, GstSingleQueue * sq)
     percent = MAX (mq->buffering_percent, percent);
 
     SET_PERCENT (mq, percent);
-  } else {
+  } else if (buffering_level < mq->low_watermark) {
     GList *iter;
     gboolean is_buffering = TRUE;
 
+    /* only look at the other queues when this one is below the low
+     * watermark, this is called for every buffer and would otherwise
+     * take the lock of each single queue every time */
     for (iter = mq->queues; iter; iter = g_list_next (iter)) {
       GstSingleQueue *oq = (GstSingleQueue *) iter->data;
 
@@ -1510,7 +1513,7 @@ update_buffering (GstMultiQueue * mq, GstSingleQueue * sq)
       }
     }
 
-    if (is_buffering && buffering_level < mq->low_watermark) {
+    if (is_buffering) {
       mq->buffering = TRUE;
       SET_PERCENT (mq, percent);
     }
@@ -1833,19 +1836,27 @@ apply_buffer (GstMultiQueue * mq, GstSingleQueue * sq, GstClockTime timestamp,
     GstClockTime duration, GstSegment * segment)
 {
   gboolean is_sink = segment == &sq->sink_segment;
-
-  GST_MULTI_QUEUE_MUTEX_LOCK (mq);
+  gboolean post;
 
   /* if no timestamp is set, assume it didn't change compared to the previous
    * buffer and simply return here. Non-time limits might have still changed
    * and a buffering message might have to be posted */
   if (timestamp == GST_CLOCK_TIME_NONE) {
+    /* nothing to update without buffering, avoid taking the global lock */
+    if (!mq->use_buffering)
+      return;
+
+    GST_MULTI_QUEUE_MUTEX_LOCK (mq);
     update_buffering (mq, sq);
+    post = mq->buffering_percent_changed;
     GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
-    gst_multi_queue_post_buffering (mq);
+    if (post)
+      gst_multi_queue_post_buffering (mq);
     return;
   }
 
+  GST_MULTI_QUEUE_MUTEX_LOCK (mq);
+
   if (is_sink && !GST_CLOCK_STIME_IS_VALID (sq->sink_start_time)) {
     sq->sink_start_time = my_segment_to_running_time (segment, timestamp);
     GST_DEBUG_ID (sq->debug_id, "Start time updated to %" GST_STIME_FORMAT,
@@ -1868,8 +1879,12 @@ apply_buffer (GstMultiQueue * mq, GstSingleQueue * sq, GstClockTime timestamp,
 
   /* calc diff with other end */
   update_time_level (mq, sq);
+  post = mq->buffering_percent_changed;
   GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
-  gst_multi_queue_post_buffering (mq);
+
+  /* only take the posting lock when there is something to post */
+  if (post)
+    gst_multi_queue_post_buffering (mq);
 }
 
 static void
@@ -1879,6 +1894,7 @@ apply_gap (GstMultiQueue * mq, GstSingleQueue * sq, GstEvent * event,
   GstClockTime timestamp;
   GstClockTime duration;
   gboolean is_sink = segment == &sq->sink_segment;
+  gboolean post;
 
   gst_event_parse_gap (event, &timestamp, &duration);
 
@@ -1909,9 +1925,11 @@ apply_gap (GstMultiQueue * mq, GstSingleQueue * sq, GstEvent * event,
 
   /* calc diff with other end */
   update_time_level (mq, sq);
+  post = mq->buffering_percent_changed;
 
   GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
-  gst_multi_queue_post_buffering (mq);
+  if (post)
+    gst_multi_queue_post_buffering (mq);
 }
 
 static GstClockTimeDiff
@@ -2174,6 +2192,7 @@ gst_multi_queue_loop (GstPad * pad)
   gboolean is_buffer;
   gboolean is_query = FALSE;
   gboolean do_update_buffering = FALSE;
+  gboolean do_post_buffering;
   gboolean dropping = FALSE;
   GstPad *srcpad = NULL;
 
@@ -2332,10 +2351,11 @@ next:
   GST_LOG_ID (sq->debug_id, "BEFORE PUSHING sq->srcresult: %s",
       gst_flow_get_name (sq->srcresult));
 
-  /* Update time stats */
-  GST_MULTI_QUEUE_MUTEX_LOCK (mq);
+  /* Update time stats. The src segment is only modified from this thread so
+   * we only need the lock when there is a time to update */
   next_time = get_running_time (&sq->src_segment, object, TRUE);
   if (GST_CLOCK_STIME_IS_VALID (next_time)) {
+    GST_MULTI_QUEUE_MUTEX_LOCK (mq);
     if (sq->last_time == GST_CLOCK_STIME_NONE || sq->last_time < next_time)
       sq->last_time = next_time;
     if (mq->high_time == GST_CLOCK_STIME_NONE || mq->high_time <= next_time) {
@@ -2343,8 +2363,8 @@ next:
       mq->high_time = next_time;
       wake_up_next_non_linked (mq);
     }
+    GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
   }
-  GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
 
   /* Try to push out the new object */
   result = gst_single_queue_push_one (mq, sq, object, &dropping);
@@ -2410,23 +2430,24 @@ next:
   if (do_update_buffering)
     update_buffering (mq, sq);
 
-  GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
-  gst_multi_queue_post_buffering (mq);
-
   GST_LOG_ID (sq->debug_id,
       "AFTER PUSHING sq->srcresult: %s (is_eos:%d)",
       gst_flow_get_name (sq->srcresult), GST_PAD_IS_EOS (srcpad));
 
   /* Need to make sure wake up any sleeping pads when we exit */
-  GST_MULTI_QUEUE_MUTEX_LOCK (mq);
   if (mq->numwaiting > 0 && (GST_PAD_IS_EOS (srcpad)
           || sq->srcresult == GST_FLOW_EOS)) {
     compute_high_time (mq, sq->groupid);
     compute_high_id (mq);
     wake_up_next_non_linked (mq);
   }
+
+  do_post_buffering = mq->buffering_percent_changed;
   GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
 
+  if (do_post_buffering)
+    gst_multi_queue_post_buffering (mq);
+
   if (dropping)
     goto next;
 
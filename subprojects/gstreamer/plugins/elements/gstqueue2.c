@@ -81,10 +81,16 @@
 #include <unistd.h>
 #endif
 
-#ifdef __BIONIC__               /* Android */
+#if defined (__BIONIC__) || defined (HAVE_POSIX_FALLOCATE)
 #include <fcntl.h>
 #endif
 
+/* access the temp file with positioned reads/writes instead of seeking the
+ * stdio stream before each access */
+#if defined (HAVE_PREAD) && defined (HAVE_PWRITE)
+#define USE_PREAD_PWRITE 1
+#endif
+
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
@@ -321,6 +327,7 @@ static void update_cur_level (GstQueue2 * queue, GstQueue2Range * range);
 static void update_in_rates (GstQueue2 * queue, gboolean force);
 static void update_buffering (GstQueue2 * queue);
 static void gst_queue2_post_buffering (GstQueue2 * queue);
+static void gst_queue2_preallocate_temp_file (GstQueue2 * queue);
 
 typedef enum
 {
@@ -1518,14 +1525,28 @@ gst_queue2_read_data_at_offset (GstQueue2 * queue, guint64 offset, guint length,
 
   ring_buffer = queue->ring_buffer;
 
+#ifndef USE_PREAD_PWRITE
   if (QUEUE_IS_USING_TEMP_FILE (queue) && FSEEK_FILE (queue->temp_file, offset))
     goto seek_failed;
+#endif
 
   /* this should not block */
   GST_LOG_OBJECT (queue, "Reading %d bytes from offset %" G_GUINT64_FORMAT,
       length, offset);
   if (QUEUE_IS_USING_TEMP_FILE (queue)) {
+#ifdef USE_PREAD_PWRITE
+    gssize ret;
+
+    do {
+      ret = pread (fileno (queue->temp_file), dst, length, offset);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0)
+      goto could_not_read;
+    res = ret;
+#else
     res = fread (dst, 1, length, queue->temp_file);
+#endif
   } else {
     memcpy (dst, ring_buffer + offset, length);
     res = length;
@@ -1536,22 +1557,30 @@ gst_queue2_read_data_at_offset (GstQueue2 * queue, guint64 offset, guint length,
   if (G_UNLIKELY (res < length)) {
     if (!QUEUE_IS_USING_TEMP_FILE (queue))
       goto could_not_read;
+#ifdef USE_PREAD_PWRITE
+    /* errors were handled above, a short read means EOF */
+    if (length > 0)
+      goto eos;
+#else
     /* check for errors or EOF */
     if (ferror (queue->temp_file))
       goto could_not_read;
     if (feof (queue->temp_file) && length > 0)
       goto eos;
+#endif
   }
 
   *read_return = res;
 
   return GST_FLOW_OK;
 
+#ifndef USE_PREAD_PWRITE
 seek_failed:
   {
     GST_ELEMENT_ERROR (queue, RESOURCE, SEEK, (NULL), GST_ERROR_SYSTEM);
     return GST_FLOW_ERROR;
   }
+#endif
 could_not_read:
   {
     GST_ELEMENT_ERROR (queue, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
@@ -1824,6 +1853,8 @@ gst_queue2_open_temp_location_file (GstQueue2 * queue)
   g_free (queue->temp_location);
   queue->temp_location = name;
 
+  gst_queue2_preallocate_temp_file (queue);
+
   GST_QUEUE2_MUTEX_UNLOCK (queue);
 
   /* we can't emit the notify with the lock */
@@ -1866,6 +1897,29 @@ open_failed:
   }
 }
 
+/* must be called with MUTEX_LOCK. The ring buffer will be filled completely,
+ * so reserve the space upfront to fail early instead of midway and get a
+ * less fragmented file */
+static void
+gst_queue2_preallocate_temp_file (GstQueue2 * queue)
+{
+#ifdef HAVE_POSIX_FALLOCATE
+  gint err;
+
+  if (queue->temp_file == NULL || !QUEUE_IS_USING_RING_BUFFER (queue))
+    return;
+
+  GST_DEBUG_OBJECT (queue, "preallocating %" G_GUINT64_FORMAT " bytes",
+      queue->ring_buffer_max_size);
+
+  err = posix_fallocate (fileno (queue->temp_file), 0,
+      queue->ring_buffer_max_size);
+  if (err != 0)
+    GST_WARNING_OBJECT (queue, "failed to preallocate temp file: %s",
+        g_strerror (err));
+#endif
+}
+
 static void
 gst_queue2_close_temp_location_file (GstQueue2 * queue)
 {
@@ -1898,6 +1952,7 @@ gst_queue2_flush_temp_file (GstQueue2 * queue)
   GST_DEBUG_OBJECT (queue, "flushing temp file");
 
   queue->temp_file = g_freopen (queue->temp_location, "wb+", queue->temp_file);
+  gst_queue2_preallocate_temp_file (queue);
 }
 
 static void
@@ -1978,6 +2033,43 @@ out_flushing:
   }
 }
 
+/* write @length bytes from @data at @offset of the temp file. Returns %FALSE
+ * with errno set on errors */
+static gboolean
+gst_queue2_write_temp_file (GstQueue2 * queue, guint64 offset,
+    const guint8 * data, guint length)
+{
+#ifdef USE_PREAD_PWRITE
+  gint fd = fileno (queue->temp_file);
+
+  while (length > 0) {
+    gssize res = pwrite (fd, data, length, offset);
+
+    if (res < 0) {
+      if (errno == EINTR)
+        continue;
+      return FALSE;
+    }
+    /* no progress, don't retry forever */
+    if (res == 0) {
+      errno = ENOSPC;
+      return FALSE;
+    }
+
+    data += res;
+    offset += res;
+    length -= res;
+  }
+
+  return TRUE;
+#else
+  if (FSEEK_FILE (queue->temp_file, offset))
+    return FALSE;
+
+  return fwrite (data, length, 1, queue->temp_file) == 1;
+#endif
+}
+
 static gboolean
 gst_queue2_create_write (GstQueue2 * queue, GstBuffer * buffer)
 {
@@ -2135,10 +2227,6 @@ gst_queue2_create_write (GstQueue2 * queue, GstBuffer * buffer)
       new_writing_pos = writing_pos + to_write;
     }
 
-    if (QUEUE_IS_USING_TEMP_FILE (queue)
-        && FSEEK_FILE (queue->temp_file, writing_pos))
-      goto seek_failed;
-
     if (new_writing_pos > writing_pos) {
       GST_INFO_OBJECT (queue,
           "writing %u bytes to range [%" G_GUINT64_FORMAT "-%" G_GUINT64_FORMAT
@@ -2146,7 +2234,7 @@ gst_queue2_create_write (GstQueue2 * queue, GstBuffer * buffer)
           queue->current->writing_pos, queue->current->rb_writing_pos);
       /* either not using ring buffer or no wrapping, just write */
       if (QUEUE_IS_USING_TEMP_FILE (queue)) {
-        if (fwrite (data, to_write, 1, queue->temp_file) != 1)
+        if (!gst_queue2_write_temp_file (queue, writing_pos, data, to_write))
           goto handle_error;
       } else {
         memcpy (ring_buffer + writing_pos, data, to_write);
@@ -2191,20 +2279,19 @@ gst_queue2_create_write (GstQueue2 * queue, GstBuffer * buffer)
         GST_INFO_OBJECT (queue, "writing %u bytes", block_one);
         /* write data to end of ring buffer */
         if (QUEUE_IS_USING_TEMP_FILE (queue)) {
-          if (fwrite (data, block_one, 1, queue->temp_file) != 1)
+          if (!gst_queue2_write_temp_file (queue, writing_pos, data,
+                  block_one))
             goto handle_error;
         } else {
           memcpy (ring_buffer + writing_pos, data, block_one);
         }
       }
 
-      if (QUEUE_IS_USING_TEMP_FILE (queue) && FSEEK_FILE (queue->temp_file, 0))
-        goto seek_failed;
-
       if (block_two > 0) {
         GST_INFO_OBJECT (queue, "writing %u bytes", block_two);
         if (QUEUE_IS_USING_TEMP_FILE (queue)) {
-          if (fwrite (data + block_one, block_two, 1, queue->temp_file) != 1)
+          if (!gst_queue2_write_temp_file (queue, 0, data + block_one,
+                  block_two))
             goto handle_error;
         } else {
           memcpy (ring_buffer, data + block_one, block_two);
@@ -2257,12 +2344,6 @@ out_flushing:
     /* FIXME - GST_FLOW_EOS ? */
     return FALSE;
   }
-seek_failed:
-  {
-    GST_ELEMENT_ERROR (queue, RESOURCE, SEEK, (NULL), GST_ERROR_SYSTEM);
-    gst_buffer_unmap (buffer, &info);
-    return FALSE;
-  }
 handle_error:
   {
     switch (errno) {
@@ -44,6 +44,11 @@
 #define FSEEK_FILE(file,offset)  (fseek (file, offset, SEEK_SET) != 0)
 #endif
 
+/* positioned I/O on the fd avoids the seeks and the stdio buffer copies */
+#if defined (HAVE_PREAD) && defined (HAVE_PWRITE)
+#define USE_PREAD_PWRITE 1
+#endif
+
 #define GST_SPARSE_FILE_IO_ERROR \
     g_quark_from_static_string("gst-sparse-file-io-error-quark")
 
@@ -54,13 +59,12 @@ typedef struct _GstSparseRange GstSparseRange;
 
 struct _GstSparseRange
 {
-  GstSparseRange *next;
-
   gsize start;
   gsize stop;
 };
 
 #define RANGE_CONTAINS(r,o) ((r)->start <= (o) && (r)->stop > (o))
+#define RANGE_INDEX(f,i) (&g_array_index ((f)->ranges, GstSparseRange, (i)))
 
 struct _GstSparseFile
 {
@@ -69,71 +73,100 @@ struct _GstSparseFile
   gsize current_pos;
   gboolean was_writing;
 
-  GstSparseRange *ranges;
-  guint n_ranges;
+  /* sorted array of non-overlapping ranges, looked up with a binary
+   * search */
+  GArray *ranges;
 
-  GstSparseRange *write_range;
-  GstSparseRange *read_range;
+  /* index of the last used ranges or -1 */
+  gint write_range;
+  gint read_range;
 };
 
-static GstSparseRange *
-get_write_range (GstSparseFile * file, gsize offset)
+/* index of the last range that starts at or before @offset, -1 if none */
+static gint
+find_range_before (GstSparseFile * file, gsize offset)
 {
-  GstSparseRange *next, *prev, *result = NULL;
-
-  if (file->write_range && file->write_range->stop == offset)
-    return file->write_range;
+  guint lo = 0, hi = file->ranges->len;
 
-  prev = NULL;
-  next = file->ranges;
-  while (next) {
-    if (next->start > offset)
-      break;
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
 
-    if (next->stop >= offset) {
-      result = next;
-      break;
-    }
-    prev = next;
-    next = next->next;
+    if (RANGE_INDEX (file, mid)->start <= offset)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
-  if (result == NULL) {
-    result = g_new0 (GstSparseRange, 1);
-    result->start = offset;
-    result->stop = offset;
-
-    result->next = next;
-    if (prev)
-      prev->next = result;
+  return (gint) lo - 1;
+}
+
+/* index of the first range that stops after @offset, -1 if none */
+static gint
+find_range_after (GstSparseFile * file, gsize offset)
+{
+  guint lo = 0, hi = file->ranges->len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (RANGE_INDEX (file, mid)->stop > offset)
+      hi = mid;
     else
-      file->ranges = result;
+      lo = mid + 1;
+  }
+  return lo < file->ranges->len ? (gint) lo : -1;
+}
+
+static gint
+get_write_range (GstSparseFile * file, gsize offset)
+{
+  GstSparseRange range;
+  gint idx;
 
-    file->write_range = result;
-    file->read_range = NULL;
+  if (file->write_range != -1
+      && RANGE_INDEX (file, file->write_range)->stop == offset)
+    return file->write_range;
 
-    file->n_ranges++;
+  /* ranges don't overlap, so only the last range starting before the offset
+   * can be extended */
+  idx = find_range_before (file, offset);
+  if (idx != -1 && RANGE_INDEX (file, idx)->stop >= offset) {
+    file->write_range = idx;
+    return idx;
   }
-  return result;
+
+  range.start = offset;
+  range.stop = offset;
+
+  idx++;
+  g_array_insert_val (file->ranges, idx, range);
+
+  file->write_range = idx;
+  file->read_range = -1;
+
+  return idx;
 }
 
 static GstSparseRange *
 get_read_range (GstSparseFile * file, gsize offset, gsize count)
 {
-  GstSparseRange *walk, *result = NULL;
+  GstSparseRange *range;
+  gint idx;
 
-  if (file->read_range && RANGE_CONTAINS (file->read_range, offset))
-    return file->read_range;
+  if (file->read_range != -1) {
+    range = RANGE_INDEX (file, file->read_range);
+    if (RANGE_CONTAINS (range, offset))
+      return range;
+  }
 
-  for (walk = file->ranges; walk; walk = walk->next) {
-    if (walk->start > offset)
-      break;
+  idx = find_range_before (file, offset);
+  if (idx == -1)
+    return NULL;
 
-    if (walk->stop >= offset + count) {
-      result = walk;
-      break;
-    }
-  }
-  return result;
+  range = RANGE_INDEX (file, idx);
+  if (range->stop < offset + count)
+    return NULL;
+
+  return range;
 }
 
 /**
@@ -152,8 +185,9 @@ gst_sparse_file_new (void)
 
   result = g_new0 (GstSparseFile, 1);
   result->current_pos = 0;
-  result->ranges = NULL;
-  result->n_ranges = 0;
+  result->ranges = g_array_new (FALSE, FALSE, sizeof (GstSparseRange));
+  result->write_range = -1;
+  result->read_range = -1;
 
   return result;
 }
@@ -181,17 +215,6 @@ gst_sparse_file_set_fd (GstSparseFile * file, gint fd)
   return file->file != NULL;
 }
 
-static void
-gst_sparse_range_free_chain (GstSparseRange * r)
-{
-  while (r != NULL) {
-    GstSparseRange *next = r->next;
-
-    g_free (r);
-    r = next;
-  }
-}
-
 /**
  * gst_sparse_file_clear:
  * @file: a #GstSparseFile
@@ -203,10 +226,10 @@ gst_sparse_file_clear (GstSparseFile * file)
 {
   g_return_if_fail (file != NULL);
 
-  gst_sparse_range_free_chain (file->ranges);
+  g_array_set_size (file->ranges, 0);
   file->current_pos = 0;
-  file->ranges = NULL;
-  file->n_ranges = 0;
+  file->write_range = -1;
+  file->read_range = -1;
   file->was_writing = FALSE;
 }
 
@@ -227,7 +250,7 @@ gst_sparse_file_free (GstSparseFile * file)
     fflush (file->file);
     fclose (file->file);
   }
-  gst_sparse_range_free_chain (file->ranges);
+  g_array_free (file->ranges, TRUE);
   g_free (file);
 }
 
@@ -255,11 +278,30 @@ gst_sparse_file_write (GstSparseFile * file, gsize offset, gconstpointer data,
 {
   GstSparseRange *range, *next;
   gsize stop;
+  gint idx;
 
   g_return_val_if_fail (file != NULL, 0);
   g_return_val_if_fail (count != 0, 0);
 
   if (file->file) {
+#ifdef USE_PREAD_PWRITE
+    const guint8 *ptr = data;
+    gsize left = count;
+    gsize pos = offset;
+
+    while (left > 0) {
+      gssize res = pwrite (file->fd, ptr, left, pos);
+
+      if (res < 0) {
+        if (errno == EINTR)
+          continue;
+        goto error;
+      }
+      ptr += res;
+      pos += res;
+      left -= res;
+    }
+#else
     if (file->current_pos != offset) {
       GST_DEBUG ("seeking to %" G_GSIZE_FORMAT, offset);
       if (FSEEK_FILE (file->file, offset))
@@ -270,17 +312,20 @@ gst_sparse_file_write (GstSparseFile * file, gsize offset, gconstpointer data,
     file->was_writing = TRUE;
     if (fwrite (data, count, 1, file->file) != 1)
       goto error;
+#endif
   }
 
   file->current_pos = offset + count;
 
   /* update the new stop position in the range */
-  range = get_write_range (file, offset);
+  idx = get_write_range (file, offset);
+  range = RANGE_INDEX (file, idx);
   stop = offset + count;
   range->stop = MAX (range->stop, stop);
 
   /* see if we can merge with next region */
-  while ((next = range->next)) {
+  while ((guint) idx + 1 < file->ranges->len) {
+    next = RANGE_INDEX (file, idx + 1);
     if (next->start > range->stop)
       break;
 
@@ -289,14 +334,16 @@ gst_sparse_file_write (GstSparseFile * file, gsize offset, gconstpointer data,
         next->start, next->stop);
 
     range->stop = MAX (next->stop, range->stop);
-    range->next = next->next;
-
-    if (file->write_range == next)
-      file->write_range = NULL;
-    if (file->read_range == next)
-      file->read_range = NULL;
-    g_free (next);
-    file->n_ranges--;
+    g_array_remove_index (file->ranges, idx + 1);
+    /* removing an element does not move the ranges before it */
+    range = RANGE_INDEX (file, idx);
+
+    /* but the cached indices after it have to follow */
+    if (file->write_range == idx + 1)
+      file->write_range = -1;
+    else if (file->write_range > idx + 1)
+      file->write_range--;
+    file->read_range = -1;
   }
   if (available)
     *available = range->stop - stop;
@@ -348,6 +395,22 @@ gst_sparse_file_read (GstSparseFile * file, gsize offset, gpointer data,
     goto no_range;
 
   if (file->file) {
+#ifdef USE_PREAD_PWRITE
+    while (res < count) {
+      gssize n = pread (file->fd, (guint8 *) data + res, count - res,
+          offset + res);
+
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        goto read_error;
+      }
+      /* EOF */
+      if (n == 0)
+        return res;
+      res += n;
+    }
+#else
     if (file->current_pos != offset) {
       GST_DEBUG ("seeking from %" G_GSIZE_FORMAT " to %" G_GSIZE_FORMAT,
           file->current_pos, offset);
@@ -360,6 +423,7 @@ gst_sparse_file_read (GstSparseFile * file, gsize offset, gpointer data,
     res = fread (data, 1, count, file->file);
     if (G_UNLIKELY (res < count))
       goto error;
+#endif
   }
 
   file->current_pos = offset + res;
@@ -376,6 +440,15 @@ no_range:
         GST_SPARSE_FILE_IO_ERROR_WOULD_BLOCK, "Offset not written to file yet");
     return 0;
   }
+#ifdef USE_PREAD_PWRITE
+read_error:
+  {
+    g_set_error (error, GST_SPARSE_FILE_IO_ERROR,
+        gst_sparse_file_io_error_from_errno (errno), "Error reading file: %s",
+        g_strerror (errno));
+    return 0;
+  }
+#else
 error:
   {
     if (ferror (file->file)) {
@@ -387,6 +460,7 @@ error:
     }
     return 0;
   }
+#endif
 }
 
 /**
@@ -404,7 +478,7 @@ gst_sparse_file_n_ranges (GstSparseFile * file)
 {
   g_return_val_if_fail (file != NULL, 0);
 
-  return file->n_ranges;
+  return file->ranges->len;
 }
 
 /**
@@ -425,19 +499,14 @@ gboolean
 gst_sparse_file_get_range_before (GstSparseFile * file, gsize offset,
     gsize * start, gsize * stop)
 {
-  GstSparseRange *walk, *result = NULL;
+  GstSparseRange *result = NULL;
+  gint idx;
 
   g_return_val_if_fail (file != NULL, FALSE);
 
-  for (walk = file->ranges; walk; walk = walk->next) {
-    GST_DEBUG ("start %" G_GSIZE_FORMAT " > %" G_GSIZE_FORMAT,
-        walk->stop, offset);
-    if (walk->start > offset)
-      break;
-
-    if (walk->start <= offset)
-      result = walk;
-  }
+  idx = find_range_before (file, offset);
+  if (idx != -1)
+    result = RANGE_INDEX (file, idx);
 
   if (result) {
     if (start)
@@ -466,18 +535,15 @@ gboolean
 gst_sparse_file_get_range_after (GstSparseFile * file, gsize offset,
     gsize * start, gsize * stop)
 {
-  GstSparseRange *walk, *result = NULL;
+  GstSparseRange *result = NULL;
+  gint idx;
 
   g_return_val_if_fail (file != NULL, FALSE);
 
-  for (walk = file->ranges; walk; walk = walk->next) {
-    GST_DEBUG ("stop %" G_GSIZE_FORMAT " > %" G_GSIZE_FORMAT,
-        walk->stop, offset);
-    if (walk->stop > offset) {
-      result = walk;
-      break;
-    }
-  }
+  idx = find_range_after (file, offset);
+  if (idx != -1)
+    result = RANGE_INDEX (file, idx);
+
   if (result) {
     if (start)
       *start = result->start;
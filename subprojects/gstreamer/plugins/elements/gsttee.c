@@ -35,6 +35,10 @@
  * provide separate threads for each branch. Otherwise a blocked dataflow in one
  * branch would stall the other branches.
  *
+ * Alternatively the #GstTeePad:async property can be set on a source pad, in
+ * which case tee keeps a small queue for that branch and pushes from a
+ * separate streaming thread taken from the default task pool.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 filesrc location=song.ogg ! decodebin ! tee name=t ! queue ! audioconvert ! audioresample ! autoaudiosink t. ! queue ! audioconvert ! goom ! videoconvert ! autovideosink
@@ -53,6 +57,8 @@
 #include "gstcoreelementselements.h"
 #include "gst/glib-compat-private.h"
 
+#include <gst/base/gstqueuearray.h>
+
 #include <string.h>
 #include <stdio.h>
 
@@ -89,6 +95,10 @@ gst_tee_pull_mode_get_type (void)
 #define DEFAULT_PULL_MODE		GST_TEE_PULL_MODE_NEVER
 #define DEFAULT_PROP_ALLOW_NOT_LINKED	FALSE
 
+#define DEFAULT_PAD_PROP_ASYNC			FALSE
+#define DEFAULT_PAD_PROP_MAX_SIZE_BUFFERS	16
+#define DEFAULT_PAD_PROP_LEAKY			FALSE
+
 enum
 {
   PROP_0,
@@ -101,6 +111,15 @@ enum
   PROP_ALLOW_NOT_LINKED,
 };
 
+enum
+{
+  PROP_PAD_0,
+  PROP_PAD_ASYNC,
+  PROP_PAD_MAX_SIZE_BUFFERS,
+  PROP_PAD_LEAKY,
+  PROP_PAD_DROPPED,
+};
+
 static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src_%u",
     GST_PAD_SRC,
     GST_PAD_REQUEST,
@@ -141,6 +160,22 @@ struct _GstTeePad
   gboolean pushed;
   GstFlowReturn result;
   gboolean removed;
+
+  /* async mode, the settings are protected with the object lock */
+  gboolean async;
+  guint max_size_buffers;
+  gboolean leaky;
+
+  /* protected by lock */
+  GMutex lock;
+  GCond cond;
+  GstQueueArray *queue;         /* of GstMiniObject */
+  guint n_buffers;              /* buffers and buffer lists in queue */
+  guint64 dropped;
+  gboolean flushing;
+  gboolean running;             /* the streaming task is started */
+  gboolean busy;                /* the streaming task is pushing an item */
+  GstFlowReturn srcresult;
 };
 
 struct _GstTeePadClass
@@ -150,9 +185,76 @@ struct _GstTeePadClass
 
 G_DEFINE_TYPE (GstTeePad, gst_tee_pad, GST_TYPE_PAD);
 
+static void gst_tee_pad_finalize (GObject * object);
+static void gst_tee_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tee_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+
 static void
 gst_tee_pad_class_init (GstTeePadClass * klass)
 {
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_tee_pad_finalize;
+  gobject_class->set_property = gst_tee_pad_set_property;
+  gobject_class->get_property = gst_tee_pad_get_property;
+
+  /**
+   * GstTeePad:async:
+   *
+   * Queue data for this pad and push it from a separate streaming thread,
+   * so that a blocked downstream branch does not stall the other branches.
+   * This avoids having to add a queue element after tee for the branch.
+   *
+   * This should be set before data starts flowing on the pad.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_ASYNC,
+      g_param_spec_boolean ("async", "Async",
+          "Push data from a separate streaming thread", DEFAULT_PAD_PROP_ASYNC,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTeePad:max-size-buffers:
+   *
+   * Maximum number of buffers (or buffer lists) queued for this pad when
+   * #GstTeePad:async is enabled, 0 for unlimited.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_MAX_SIZE_BUFFERS,
+      g_param_spec_uint ("max-size-buffers", "Max. size (buffers)",
+          "Max. number of buffers queued in async mode (0=disable)",
+          0, G_MAXUINT, DEFAULT_PAD_PROP_MAX_SIZE_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTeePad:leaky:
+   *
+   * When the queue of an async pad is full, drop the oldest queued buffer
+   * instead of blocking upstream.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_LEAKY,
+      g_param_spec_boolean ("leaky", "Leaky",
+          "Drop old buffers instead of blocking when the async queue is full",
+          DEFAULT_PAD_PROP_LEAKY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTeePad:dropped:
+   *
+   * Number of buffers dropped because the queue of a leaky async pad was
+   * full.
+   *
+   * Since: 1.26
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_DROPPED,
+      g_param_spec_uint64 ("dropped", "Dropped",
+          "Number of buffers dropped by the leaky async queue", 0, G_MAXUINT64,
+          0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -167,6 +269,303 @@ static void
 gst_tee_pad_init (GstTeePad * pad)
 {
   gst_tee_pad_reset (pad);
+
+  pad->async = DEFAULT_PAD_PROP_ASYNC;
+  pad->max_size_buffers = DEFAULT_PAD_PROP_MAX_SIZE_BUFFERS;
+  pad->leaky = DEFAULT_PAD_PROP_LEAKY;
+
+  g_mutex_init (&pad->lock);
+  g_cond_init (&pad->cond);
+  pad->queue = gst_queue_array_new (DEFAULT_PAD_PROP_MAX_SIZE_BUFFERS);
+  pad->srcresult = GST_FLOW_OK;
+}
+
+/* WITH pad->lock */
+static void
+gst_tee_pad_flush_queue (GstTeePad * pad)
+{
+  GstMiniObject *obj;
+
+  while ((obj = gst_queue_array_pop_head (pad->queue)))
+    gst_mini_object_unref (obj);
+  pad->n_buffers = 0;
+}
+
+static void
+gst_tee_pad_finalize (GObject * object)
+{
+  GstTeePad *pad = GST_TEE_PAD_CAST (object);
+
+  gst_tee_pad_flush_queue (pad);
+  gst_queue_array_free (pad->queue);
+  g_cond_clear (&pad->cond);
+  g_mutex_clear (&pad->lock);
+
+  G_OBJECT_CLASS (gst_tee_pad_parent_class)->finalize (object);
+}
+
+static void
+gst_tee_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTeePad *pad = GST_TEE_PAD_CAST (object);
+
+  switch (prop_id) {
+    case PROP_PAD_ASYNC:
+      GST_OBJECT_LOCK (pad);
+      pad->async = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (pad);
+      break;
+    case PROP_PAD_MAX_SIZE_BUFFERS:
+      g_mutex_lock (&pad->lock);
+      pad->max_size_buffers = g_value_get_uint (value);
+      /* the queue might not be full anymore */
+      g_cond_broadcast (&pad->cond);
+      g_mutex_unlock (&pad->lock);
+      break;
+    case PROP_PAD_LEAKY:
+      g_mutex_lock (&pad->lock);
+      pad->leaky = g_value_get_boolean (value);
+      g_cond_broadcast (&pad->cond);
+      g_mutex_unlock (&pad->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_tee_pad_get_property (GObject * object, guint prop_id, GValue * value,
+    GParamSpec * pspec)
+{
+  GstTeePad *pad = GST_TEE_PAD_CAST (object);
+
+  switch (prop_id) {
+    case PROP_PAD_ASYNC:
+      GST_OBJECT_LOCK (pad);
+      g_value_set_boolean (value, pad->async);
+      GST_OBJECT_UNLOCK (pad);
+      break;
+    case PROP_PAD_MAX_SIZE_BUFFERS:
+      g_mutex_lock (&pad->lock);
+      g_value_set_uint (value, pad->max_size_buffers);
+      g_mutex_unlock (&pad->lock);
+      break;
+    case PROP_PAD_LEAKY:
+      g_mutex_lock (&pad->lock);
+      g_value_set_boolean (value, pad->leaky);
+      g_mutex_unlock (&pad->lock);
+      break;
+    case PROP_PAD_DROPPED:
+      g_mutex_lock (&pad->lock);
+      g_value_set_uint64 (value, pad->dropped);
+      g_mutex_unlock (&pad->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static gboolean
+gst_tee_pad_is_async (GstTeePad * pad)
+{
+  gboolean async;
+
+  GST_OBJECT_LOCK (pad);
+  async = pad->async;
+  GST_OBJECT_UNLOCK (pad);
+
+  return async;
+}
+
+static void
+gst_tee_pad_loop (GstTeePad * pad)
+{
+  GstMiniObject *obj;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&pad->lock);
+  while (!pad->flushing && gst_queue_array_is_empty (pad->queue))
+    g_cond_wait (&pad->cond, &pad->lock);
+
+  if (pad->flushing)
+    goto out_flushing;
+
+  obj = gst_queue_array_pop_head (pad->queue);
+  if (!GST_IS_EVENT (obj))
+    pad->n_buffers--;
+  pad->busy = TRUE;
+  /* wake up upstream waiting for space */
+  g_cond_broadcast (&pad->cond);
+  g_mutex_unlock (&pad->lock);
+
+  if (GST_IS_BUFFER (obj)) {
+    ret = gst_pad_push (GST_PAD_CAST (pad), GST_BUFFER_CAST (obj));
+  } else if (GST_IS_BUFFER_LIST (obj)) {
+    ret = gst_pad_push_list (GST_PAD_CAST (pad), GST_BUFFER_LIST_CAST (obj));
+  } else {
+    GstEvent *event = GST_EVENT_CAST (obj);
+    gboolean is_eos = GST_EVENT_TYPE (event) == GST_EVENT_EOS;
+
+    gst_pad_push_event (GST_PAD_CAST (pad), event);
+    if (is_eos)
+      ret = GST_FLOW_EOS;
+  }
+
+  g_mutex_lock (&pad->lock);
+  pad->busy = FALSE;
+  g_cond_broadcast (&pad->cond);
+
+  if (pad->flushing)
+    goto out_flushing;
+
+  /* a new stream might already be queued after EOS */
+  if (ret == GST_FLOW_EOS && !gst_queue_array_is_empty (pad->queue))
+    ret = GST_FLOW_OK;
+
+  /* like the non-async case, a not-linked branch doesn't stop the others */
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_NOT_LINKED) {
+    GST_DEBUG_OBJECT (pad, "pausing task, reason %s", gst_flow_get_name (ret));
+    pad->srcresult = ret;
+    pad->running = FALSE;
+    gst_tee_pad_flush_queue (pad);
+    gst_pad_pause_task (GST_PAD_CAST (pad));
+  } else if (ret != pad->srcresult) {
+    pad->srcresult = ret;
+  }
+  g_mutex_unlock (&pad->lock);
+
+  return;
+
+out_flushing:
+  {
+    GST_DEBUG_OBJECT (pad, "pausing task, flushing");
+    pad->running = FALSE;
+    gst_pad_pause_task (GST_PAD_CAST (pad));
+    g_mutex_unlock (&pad->lock);
+    return;
+  }
+}
+
+/* WITH pad->lock, drops the oldest buffer or buffer list from the queue
+ * while keeping the serialized events */
+static void
+gst_tee_pad_drop_oldest (GstTeePad * pad)
+{
+  guint i, len;
+
+  len = gst_queue_array_get_length (pad->queue);
+  for (i = 0; i < len; i++) {
+    GstMiniObject *obj = gst_queue_array_peek_nth (pad->queue, i);
+
+    if (!GST_IS_EVENT (obj)) {
+      gst_queue_array_drop_element (pad->queue, i);
+      GST_LOG_OBJECT (pad, "queue full, dropping %" GST_PTR_FORMAT, obj);
+      gst_mini_object_unref (obj);
+      pad->n_buffers--;
+      pad->dropped++;
+      break;
+    }
+  }
+}
+
+/* takes ownership of @obj */
+static GstFlowReturn
+gst_tee_pad_enqueue (GstTeePad * pad, GstMiniObject * obj)
+{
+  GstFlowReturn ret;
+  gboolean start;
+
+  g_mutex_lock (&pad->lock);
+  if (pad->flushing)
+    goto flushing;
+
+  /* a new stream can start after EOS */
+  if (pad->srcresult == GST_FLOW_EOS && GST_IS_EVENT (obj)
+      && GST_EVENT_TYPE (obj) == GST_EVENT_STREAM_START)
+    pad->srcresult = GST_FLOW_OK;
+
+  ret = pad->srcresult;
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_NOT_LINKED)
+    goto out_flow_error;
+
+  if (!GST_IS_EVENT (obj)) {
+    while (pad->max_size_buffers > 0
+        && pad->n_buffers >= pad->max_size_buffers) {
+      if (pad->leaky) {
+        gst_tee_pad_drop_oldest (pad);
+        continue;
+      }
+
+      g_cond_wait (&pad->cond, &pad->lock);
+      if (pad->flushing)
+        goto flushing;
+    }
+    pad->n_buffers++;
+  }
+
+  gst_queue_array_push_tail (pad->queue, obj);
+  g_cond_broadcast (&pad->cond);
+
+  start = !pad->running;
+  pad->running = TRUE;
+  g_mutex_unlock (&pad->lock);
+
+  if (start)
+    gst_pad_start_task (GST_PAD_CAST (pad), (GstTaskFunction) gst_tee_pad_loop,
+        pad, NULL);
+
+  return ret;
+
+flushing:
+  {
+    g_mutex_unlock (&pad->lock);
+    GST_LOG_OBJECT (pad, "flushing, dropping %" GST_PTR_FORMAT, obj);
+    gst_mini_object_unref (obj);
+    return GST_FLOW_FLUSHING;
+  }
+out_flow_error:
+  {
+    g_mutex_unlock (&pad->lock);
+    GST_LOG_OBJECT (pad, "branch returned %s, dropping %" GST_PTR_FORMAT,
+        gst_flow_get_name (ret), obj);
+    /* nothing will push the EOS, make sure the error is not lost */
+    if (ret < GST_FLOW_EOS && GST_IS_EVENT (obj)
+        && GST_EVENT_TYPE (obj) == GST_EVENT_EOS) {
+      GstElement *parent = GST_PAD_PARENT (pad);
+
+      if (parent)
+        GST_ELEMENT_FLOW_ERROR (parent, ret);
+    }
+    gst_mini_object_unref (obj);
+    return ret;
+  }
+}
+
+/* waits until everything queued on an async pad was pushed, used before
+ * forwarding serialized queries */
+static void
+gst_tee_pad_wait_drained (GstTeePad * pad)
+{
+  g_mutex_lock (&pad->lock);
+  while (!pad->flushing && pad->running && (pad->busy
+          || !gst_queue_array_is_empty (pad->queue)))
+    g_cond_wait (&pad->cond, &pad->lock);
+  g_mutex_unlock (&pad->lock);
+}
+
+static void
+gst_tee_pad_set_flushing (GstTeePad * pad, gboolean flushing)
+{
+  g_mutex_lock (&pad->lock);
+  pad->flushing = flushing;
+  gst_tee_pad_flush_queue (pad);
+  if (!flushing)
+    pad->srcresult = GST_FLOW_OK;
+  g_cond_broadcast (&pad->cond);
+  g_mutex_unlock (&pad->lock);
 }
 
 static GstPad *gst_tee_request_new_pad (GstElement * element,
@@ -294,13 +693,15 @@ gst_tee_class_init (GstTeeClass * klass)
       "1-to-N pipe fitting",
       "Erik Walthinsen <omega@cse.ogi.edu>, " "Wim Taymans <wim@fluendo.com>");
   gst_element_class_add_static_pad_template (gstelement_class, &sinktemplate);
-  gst_element_class_add_static_pad_template (gstelement_class, &src_template);
+  gst_element_class_add_static_pad_template_with_gtype (gstelement_class,
+      &src_template, GST_TYPE_TEE_PAD);
 
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_tee_request_new_pad);
   gstelement_class->release_pad = GST_DEBUG_FUNCPTR (gst_tee_release_pad);
 
   gst_type_mark_as_plugin_api (GST_TYPE_TEE_PULL_MODE, 0);
+  gst_type_mark_as_plugin_api (GST_TYPE_TEE_PAD, 0);
 }
 
 static void
@@ -551,14 +952,98 @@ gst_tee_get_property (GObject * object, guint prop_id, GValue * value,
   GST_OBJECT_UNLOCK (tee);
 }
 
+static gboolean
+gst_tee_has_async_pads (GstTee * tee)
+{
+  GList *pads;
+  gboolean res = FALSE;
+
+  GST_OBJECT_LOCK (tee);
+  for (pads = GST_ELEMENT_CAST (tee)->srcpads; pads; pads = pads->next) {
+    if (gst_tee_pad_is_async (GST_TEE_PAD_CAST (pads->data))) {
+      res = TRUE;
+      break;
+    }
+  }
+  GST_OBJECT_UNLOCK (tee);
+
+  return res;
+}
+
+struct EventForwardCtx
+{
+  GstEvent *event;
+  gboolean dispatched;
+  gboolean result;
+};
+
+static gboolean
+gst_tee_forward_event (GstPad * pad, gpointer user_data)
+{
+  struct EventForwardCtx *ctx = user_data;
+  GstTeePad *tpad = GST_TEE_PAD_CAST (pad);
+  GstEvent *event = ctx->event;
+  GstFlowReturn ret;
+
+  ctx->dispatched = TRUE;
+
+  if (!gst_tee_pad_is_async (tpad)) {
+    ctx->result |= gst_pad_push_event (pad, gst_event_ref (event));
+    /* don't stop */
+    return FALSE;
+  }
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      ctx->result |= gst_pad_push_event (pad, gst_event_ref (event));
+      /* unblock and stop the streaming thread */
+      gst_tee_pad_set_flushing (tpad, TRUE);
+      gst_pad_pause_task (pad);
+      /* the task might have been paused between two iterations without
+       * seeing the flushing flag, make sure the next enqueue restarts it */
+      g_mutex_lock (&tpad->lock);
+      tpad->running = FALSE;
+      g_mutex_unlock (&tpad->lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      /* the streaming thread is restarted with the next queued item */
+      gst_tee_pad_set_flushing (tpad, FALSE);
+      ctx->result |= gst_pad_push_event (pad, gst_event_ref (event));
+      break;
+    default:
+      if (GST_EVENT_IS_SERIALIZED (event)) {
+        ret = gst_tee_pad_enqueue (tpad,
+            GST_MINI_OBJECT_CAST (gst_event_ref (event)));
+        ctx->result |= (ret == GST_FLOW_OK || ret == GST_FLOW_NOT_LINKED);
+      } else {
+        ctx->result |= gst_pad_push_event (pad, gst_event_ref (event));
+      }
+      break;
+  }
+
+  /* don't stop */
+  return FALSE;
+}
+
 static gboolean
 gst_tee_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
+  GstTee *tee = GST_TEE_CAST (parent);
   gboolean res;
 
   switch (GST_EVENT_TYPE (event)) {
     default:
-      res = gst_pad_event_default (pad, parent, event);
+      if (gst_tee_has_async_pads (tee)) {
+        struct EventForwardCtx ctx = { event, FALSE, FALSE };
+
+        /* serialized events need to stay in order with the data queued on
+         * async pads */
+        gst_pad_forward (pad, gst_tee_forward_event, &ctx);
+        res = ctx.dispatched ? ctx.result : TRUE;
+        gst_event_unref (event);
+      } else {
+        res = gst_pad_event_default (pad, parent, event);
+      }
       break;
   }
 
@@ -813,6 +1298,22 @@ gst_tee_sink_query (GstPad * pad, GstObject * parent, GstQuery * query)
       break;
     }
     default:
+      if (GST_QUERY_IS_SERIALIZED (query) && gst_tee_has_async_pads (tee)) {
+        GList *pads, *l;
+
+        /* serialized queries must only be answered once all previously
+         * queued data was handled downstream */
+        GST_OBJECT_LOCK (tee);
+        pads = g_list_copy_deep (GST_ELEMENT_CAST (tee)->srcpads,
+            (GCopyFunc) gst_object_ref, NULL);
+        GST_OBJECT_UNLOCK (tee);
+
+        for (l = pads; l; l = l->next) {
+          if (gst_tee_pad_is_async (GST_TEE_PAD_CAST (l->data)))
+            gst_tee_pad_wait_drained (GST_TEE_PAD_CAST (l->data));
+        }
+        g_list_free_full (pads, gst_object_unref);
+      }
       res = gst_pad_query_default (pad, parent, query);
       break;
   }
@@ -848,6 +1349,9 @@ gst_tee_do_push (GstTee * tee, GstPad * pad, gpointer data, gboolean is_list)
   if (pad == tee->pull_pad) {
     /* don't push on the pad we're pulling from */
     res = GST_FLOW_OK;
+  } else if (gst_tee_pad_is_async (GST_TEE_PAD_CAST (pad))) {
+    res = gst_tee_pad_enqueue (GST_TEE_PAD_CAST (pad),
+        gst_mini_object_ref (GST_MINI_OBJECT_CAST (data)));
   } else if (is_list) {
     res =
         gst_pad_push_list (pad,
@@ -893,6 +1397,9 @@ gst_tee_handle_data (GstTee * tee, gpointer data, gboolean is_list)
 
     if (pad == tee->pull_pad) {
       ret = GST_FLOW_OK;
+    } else if (gst_tee_pad_is_async (GST_TEE_PAD_CAST (pad))) {
+      ret = gst_tee_pad_enqueue (GST_TEE_PAD_CAST (pad),
+          GST_MINI_OBJECT_CAST (data));
     } else if (is_list) {
       ret = gst_pad_push_list (pad, GST_BUFFER_LIST_CAST (data));
     } else {
@@ -1127,6 +1634,22 @@ gst_tee_src_activate_mode (GstPad * pad, GstObject * parent, GstPadMode mode,
       GST_OBJECT_UNLOCK (tee);
       break;
     }
+    case GST_PAD_MODE_PUSH:
+    {
+      GstTeePad *tpad = GST_TEE_PAD_CAST (pad);
+
+      /* stop the streaming thread used in async mode */
+      gst_tee_pad_set_flushing (tpad, !active);
+      if (active) {
+        res = TRUE;
+      } else {
+        res = gst_pad_stop_task (pad);
+        g_mutex_lock (&tpad->lock);
+        tpad->running = FALSE;
+        g_mutex_unlock (&tpad->lock);
+      }
+      break;
+    }
     default:
       res = TRUE;
       break;
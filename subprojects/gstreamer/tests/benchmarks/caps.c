@@ -1,7 +1,7 @@
 /* GStreamer
  * Copyright (C) 2005 Andy Wingo <wingo@pobox.com>
  *
- * caps.c: benchmark for caps creation and destruction
+ * caps.c: benchmark for caps creation, destruction and set operations
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Library General Public
@@ -40,12 +40,27 @@
   "rate = (int) [ 1, MAX ], " \
   "channels = (int) [ 1, MAX ]"
 
+/* mixes audio and video structures with fixed values, ranges and lists so
+ * that the intersect, subtract and union functions for different value types
+ * are exercised */
+#define MIXED_CAPS \
+  "audio/x-raw, format = (string) S16LE, rate = (int) 44100, " \
+  "channels = (int) 2; " \
+  "audio/x-raw, format = (string) { F32LE, S32LE }, rate = (int) [ 8000, " \
+  "96000 ], channels = (int) { 1, 2, 6 }; " \
+  "video/x-raw, format = (string) I420, width = (int) [ 16, 4096 ], " \
+  "height = (int) [ 16, 4096 ], framerate = (fraction) [ 0/1, 60/1 ]"
+
+#define VIDEO_TEMPLATE_CAPS \
+  "video/x-raw, format = (string) { I420, YV12, NV12 }, " \
+  "width = (int) 1920, height = (int) 1080, framerate = (fraction) 30/1"
+
 
 gint
 main (gint argc, gchar * argv[])
 {
   GstCaps **capses;
-  GstCaps *protocaps;
+  GstCaps *protocaps, *mixedcaps, *videocaps, *res;
   GstClockTime start, end;
   gint i;
 
@@ -61,6 +76,53 @@ main (gint argc, gchar * argv[])
   g_print ("%" GST_TIME_FORMAT " - creating %d caps\n",
       GST_TIME_ARGS (end - start), i);
 
+  mixedcaps = gst_caps_from_string (MIXED_CAPS);
+  videocaps = gst_caps_from_string (VIDEO_TEMPLATE_CAPS);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_CAPS; i++) {
+    res = gst_caps_intersect (capses[i], mixedcaps);
+    gst_caps_unref (res);
+    res = gst_caps_intersect (videocaps, mixedcaps);
+    gst_caps_unref (res);
+  }
+  end = gst_util_get_timestamp ();
+  g_print ("%" GST_TIME_FORMAT " - intersecting %d caps\n",
+      GST_TIME_ARGS (end - start), i);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_CAPS; i++) {
+    res = gst_caps_subtract (capses[i], mixedcaps);
+    gst_caps_unref (res);
+    res = gst_caps_subtract (mixedcaps, videocaps);
+    gst_caps_unref (res);
+  }
+  end = gst_util_get_timestamp ();
+  g_print ("%" GST_TIME_FORMAT " - subtracting %d caps\n",
+      GST_TIME_ARGS (end - start), i);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_CAPS; i++) {
+    gst_caps_is_subset (mixedcaps, capses[i]);
+    gst_caps_is_subset (videocaps, mixedcaps);
+  }
+  end = gst_util_get_timestamp ();
+  g_print ("%" GST_TIME_FORMAT " - checking subsets of %d caps\n",
+      GST_TIME_ARGS (end - start), i);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_CAPS; i++) {
+    res = gst_caps_merge (gst_caps_ref (capses[i]), gst_caps_ref (mixedcaps));
+    res = gst_caps_simplify (res);
+    gst_caps_unref (res);
+  }
+  end = gst_util_get_timestamp ();
+  g_print ("%" GST_TIME_FORMAT " - merging %d caps\n",
+      GST_TIME_ARGS (end - start), i);
+
+  gst_caps_unref (videocaps);
+  gst_caps_unref (mixedcaps);
+
   start = gst_util_get_timestamp ();
   for (i = 0; i < NUM_CAPS; i++)
     gst_caps_unref (capses[i]);
@@ -0,0 +1,168 @@
+/* GStreamer
+ *
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * pipelines.c: throughput of a set of canonical pipelines
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Runs each pipeline until EOS and prints one line of comma separated values
+ * per pipeline, suitable for regression tracking. Every pipeline must end in
+ * a fakesink named "sink", which collects the timing statistics. The number
+ * of buffers produced by the default pipelines can be set with the
+ * GST_BENCHMARK_BUFFERS environment variable.
+ *
+ * Additional pipelines can be given on the command line, for example:
+ *
+ *   pipelines "videotestsrc num-buffers=1000 ! videoconvert ! \
+ *       video/x-raw,format=I420 ! fakesink name=sink"
+ */
+
+#include <gst/gst.h>
+
+#define BUFFER_COUNT 100000
+
+static const gchar *default_pipelines[] = {
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! fakesink name=sink",
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! identity ! identity ! identity ! fakesink name=sink",
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! queue ! fakesink name=sink",
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! queue2 ! fakesink name=sink",
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! multiqueue ! fakesink name=sink",
+  "fakesrc name=src sizetype=fixed filltype=nothing sizemax=4096 "
+      "! tee name=t ! queue ! fakesink name=sink t. ! queue ! fakesink",
+};
+
+static gboolean
+run_pipeline (const gchar * description, guint buffers)
+{
+  GstElement *pipeline, *src, *sink;
+  GstStructure *stats;
+  GstMessage *msg;
+  GError *error = NULL;
+  GstClockTime start, end;
+  guint64 num_buffers = 0, num_bytes = 0, min_interval = 0, max_interval = 0;
+  gdouble buffers_per_second = 0.0, bytes_per_second = 0.0;
+  gboolean ret = TRUE;
+
+  pipeline = gst_parse_launch (description, &error);
+  if (!pipeline) {
+    g_printerr ("could not create pipeline \"%s\": %s\n", description,
+        error->message);
+    g_clear_error (&error);
+    return FALSE;
+  }
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  if (!sink) {
+    g_printerr ("pipeline \"%s\" has no element named \"sink\"\n",
+        description);
+    gst_object_unref (pipeline);
+    return FALSE;
+  }
+  g_object_set (sink, "enable-timing-stats", TRUE, NULL);
+
+  if (buffers > 0 && (src = gst_bin_get_by_name (GST_BIN (pipeline), "src"))) {
+    g_object_set (src, "num-buffers", buffers, NULL);
+    gst_object_unref (src);
+  }
+
+  start = gst_util_get_timestamp ();
+  if (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+    g_printerr ("could not start pipeline \"%s\"\n", description);
+    ret = FALSE;
+    goto done;
+  }
+
+  msg = gst_bus_poll (GST_ELEMENT_BUS (pipeline),
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  end = gst_util_get_timestamp ();
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &error, NULL);
+    g_printerr ("error running pipeline \"%s\": %s\n", description,
+        error->message);
+    g_clear_error (&error);
+    ret = FALSE;
+  }
+  gst_message_unref (msg);
+
+  if (ret) {
+    g_object_get (sink, "timing-stats", &stats, NULL);
+    gst_structure_get (stats,
+        "num-buffers", G_TYPE_UINT64, &num_buffers,
+        "num-bytes", G_TYPE_UINT64, &num_bytes,
+        "min-interval", G_TYPE_UINT64, &min_interval,
+        "max-interval", G_TYPE_UINT64, &max_interval,
+        "buffers-per-second", G_TYPE_DOUBLE, &buffers_per_second,
+        "bytes-per-second", G_TYPE_DOUBLE, &bytes_per_second, NULL);
+    gst_structure_free (stats);
+
+    g_print ("\"%s\",%" G_GUINT64_FORMAT ",%" G_GUINT64_FORMAT ",%"
+        G_GUINT64_FORMAT ",%.0f,%.0f,%" G_GUINT64_FORMAT ",%" G_GUINT64_FORMAT
+        "\n", description, end - start, num_buffers, num_bytes,
+        buffers_per_second, bytes_per_second, min_interval, max_interval);
+  }
+
+done:
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  guint buffers = BUFFER_COUNT;
+  gboolean ret = TRUE;
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  g_print ("pipeline,total_ns,num_buffers,num_bytes,buffers_per_second,"
+      "bytes_per_second,min_interval_ns,max_interval_ns\n");
+
+  if (argc > 1) {
+    for (i = 1; i < (guint) argc; i++)
+      ret &= run_pipeline (argv[i], 0);
+  } else {
+    const gchar *env = g_getenv ("GST_BENCHMARK_BUFFERS");
+
+    if (env) {
+      gchar *end;
+      guint64 val = g_ascii_strtoull (env, &end, 10);
+
+      if (end == env || *end != '\0' || val == 0 || val > G_MAXUINT) {
+        g_printerr ("Invalid GST_BENCHMARK_BUFFERS value '%s'\n", env);
+        return 1;
+      }
+      buffers = val;
+    }
+
+    for (i = 0; i < G_N_ELEMENTS (default_pipelines); i++)
+      ret &= run_pipeline (default_pipelines[i], buffers);
+  }
+
+  return ret ? 0 : 1;
+}
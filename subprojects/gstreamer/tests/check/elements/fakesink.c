@@ -1345,6 +1345,72 @@ GST_START_TEST (test_last_message_deep_notify)
 
 GST_END_TEST;
 
+GST_START_TEST (test_timing_stats)
+{
+  GstElement *pipe, *src, *sink;
+  GstStructure *stats;
+  const GValue *histogram;
+  guint64 num_buffers, num_bytes, total = 0;
+  guint64 num_latencies, min_latency, max_latency;
+  GstMessage *m;
+  guint i;
+
+  pipe = gst_pipeline_new ("pipeline");
+  src = gst_element_factory_make ("fakesrc", NULL);
+  gst_util_set_object_arg (G_OBJECT (src), "sizetype", "fixed");
+  g_object_set (src, "num-buffers", NUM_BUFFERS, "sizemax", 16,
+      "format", GST_FORMAT_TIME, "is-live", TRUE, "do-timestamp", TRUE, NULL);
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "enable-timing-stats", TRUE, NULL);
+
+  gst_bin_add_many (GST_BIN (pipe), src, sink, NULL);
+  fail_unless (gst_element_link (src, sink));
+
+  fail_unless_equals_int (gst_element_set_state (pipe, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_NO_PREROLL);
+
+  m = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipe), -1, GST_MESSAGE_EOS);
+  gst_message_unref (m);
+
+  g_object_get (sink, "timing-stats", &stats, NULL);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "num-buffers", &num_buffers));
+  fail_unless (gst_structure_get_uint64 (stats, "num-bytes", &num_bytes));
+  fail_unless_equals_uint64 (num_buffers, NUM_BUFFERS);
+  fail_unless_equals_uint64 (num_bytes, NUM_BUFFERS * 16);
+
+  /* one interval between each pair of buffers */
+  histogram = gst_structure_get_value (stats, "interval-histogram");
+  fail_unless (histogram != NULL);
+  for (i = 0; i < gst_value_array_get_size (histogram); i++)
+    total += g_value_get_uint64 (gst_value_array_get_value (histogram, i));
+  fail_unless_equals_uint64 (total, NUM_BUFFERS - 1);
+
+  /* the live source timestamps every buffer with the clock running time,
+   * so each one has a processing latency */
+  fail_unless (gst_structure_get_uint64 (stats, "num-latencies",
+          &num_latencies));
+  fail_unless_equals_uint64 (num_latencies, NUM_BUFFERS);
+  fail_unless (gst_structure_get_uint64 (stats, "min-latency", &min_latency));
+  fail_unless (gst_structure_get_uint64 (stats, "max-latency", &max_latency));
+  fail_unless (min_latency <= max_latency);
+  histogram = gst_structure_get_value (stats, "latency-histogram");
+  fail_unless (histogram != NULL);
+  total = 0;
+  for (i = 0; i < gst_value_array_get_size (histogram); i++)
+    total += g_value_get_uint64 (gst_value_array_get_value (histogram, i));
+  fail_unless_equals_uint64 (total, NUM_BUFFERS);
+  gst_structure_free (stats);
+
+  fail_unless_equals_int (gst_element_set_state (pipe, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+
+  gst_object_unref (pipe);
+}
+
+GST_END_TEST;
+
 static Suite *
 fakesink_suite (void)
 {
@@ -1362,6 +1428,7 @@ fakesink_suite (void)
   tcase_add_test (tc_chain, test_position_non_resetting_flush);
   tcase_add_test (tc_chain, test_notify_race);
   tcase_add_test (tc_chain, test_last_message_notify);
+  tcase_add_test (tc_chain, test_timing_stats);
   tcase_skip_broken_test (tc_chain, test_last_message_deep_notify);
 
   return s;
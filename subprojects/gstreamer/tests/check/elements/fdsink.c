@@ -0,0 +1,188 @@
+/* GStreamer
+ *
+ * unit test for fdsink
+ *
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <gst/check/gstcheck.h>
+
+static GstPad *mysrcpad;
+
+static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+static GstElement *
+setup_fdsink (void)
+{
+  GstElement *fdsink;
+
+  GST_DEBUG ("setup_fdsink");
+  fdsink = gst_check_setup_element ("fdsink");
+  mysrcpad = gst_check_setup_src_pad (fdsink, &srctemplate);
+  gst_pad_set_active (mysrcpad, TRUE);
+  return fdsink;
+}
+
+static void
+cleanup_fdsink (GstElement * fdsink)
+{
+  gst_pad_set_active (mysrcpad, FALSE);
+  gst_check_teardown_src_pad (fdsink);
+  gst_check_teardown_element (fdsink);
+}
+
+#if defined (HAVE_PIPE) && defined (G_OS_UNIX) && defined (O_NONBLOCK)
+
+/* More memories than fit into a single writev() call */
+#define NUM_BUFFERS 1500
+
+typedef struct
+{
+  gint fd;
+  guint8 *data;
+  gsize size;
+} ReadData;
+
+static gpointer
+read_thread_func (ReadData * rd)
+{
+  gsize offset = 0;
+
+  while (offset < rd->size) {
+    gssize ret;
+
+    /* read slowly in small chunks so that the writer keeps filling up the
+     * pipe and gets short writes */
+    ret = read (rd->fd, rd->data + offset, MIN (rd->size - offset, 1000));
+    if (ret < 0 && (errno == EINTR || errno == EAGAIN))
+      continue;
+    if (ret <= 0)
+      break;
+    offset += ret;
+    g_usleep (50);
+  }
+
+  return GSIZE_TO_POINTER (offset);
+}
+
+GST_START_TEST (test_short_writes)
+{
+  GstElement *sink;
+  GstBufferList *list;
+  ReadData rd;
+  GThread *thread;
+  gint pipe_fd[2];
+  gsize total = 0, offset = 0, i;
+  guint8 *expected;
+  gint flags;
+
+  fail_if (pipe (pipe_fd) < 0);
+
+  /* A non-blocking pipe with a small buffer makes writev() return after
+   * writing only parts of the vectors */
+  flags = fcntl (pipe_fd[1], F_GETFL, 0);
+  fcntl (pipe_fd[1], F_SETFL, flags | O_NONBLOCK);
+#ifdef F_SETPIPE_SZ
+  fcntl (pipe_fd[1], F_SETPIPE_SZ, 4096);
+#endif
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    GstBuffer *buf = gst_buffer_new ();
+    gsize sizes[2] = { (i % 97) + 1, (i % 13) + 1 };
+    guint m;
+
+    for (m = 0; m < 2; m++) {
+      GstMemory *mem = gst_allocator_alloc (NULL, sizes[m], NULL);
+      GstMapInfo map;
+      gsize j;
+
+      fail_unless (gst_memory_map (mem, &map, GST_MAP_WRITE));
+      for (j = 0; j < map.size; j++)
+        map.data[j] = (total + j) % 251;
+      gst_memory_unmap (mem, &map);
+      gst_buffer_append_memory (buf, mem);
+      total += sizes[m];
+    }
+    gst_buffer_list_add (list, buf);
+  }
+
+  rd.fd = pipe_fd[0];
+  rd.size = total;
+  rd.data = g_malloc0 (total);
+  thread = g_thread_new ("reader", (GThreadFunc) read_thread_func, &rd);
+
+  sink = setup_fdsink ();
+  g_object_set (sink, "fd", pipe_fd[1], "sync", FALSE, NULL);
+  fail_unless (gst_element_set_state (sink,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_ASYNC,
+      "could not set to playing");
+
+  gst_check_setup_events (mysrcpad, sink, NULL, GST_FORMAT_BYTES);
+  fail_unless_equals_int (gst_pad_push_list (mysrcpad, list), GST_FLOW_OK);
+
+  offset = GPOINTER_TO_SIZE (g_thread_join (thread));
+  fail_unless_equals_uint64 (offset, total);
+
+  /* Every byte must arrive exactly once and in order */
+  expected = g_malloc (total);
+  for (i = 0; i < total; i++)
+    expected[i] = i % 251;
+  fail_unless (memcmp (rd.data, expected, total) == 0);
+  g_free (expected);
+  g_free (rd.data);
+
+  fail_unless (gst_element_set_state (sink,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS, "could not set to null");
+
+  cleanup_fdsink (sink);
+  close (pipe_fd[0]);
+  close (pipe_fd[1]);
+}
+
+GST_END_TEST;
+#endif
+
+static Suite *
+fdsink_suite (void)
+{
+  Suite *s = suite_create ("fdsink");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+#if defined (HAVE_PIPE) && defined (G_OS_UNIX) && defined (O_NONBLOCK)
+  tcase_add_test (tc_chain, test_short_writes);
+#endif
+
+  return s;
+}
+
+GST_CHECK_MAIN (fdsink);
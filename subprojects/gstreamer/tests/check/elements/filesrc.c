@@ -21,6 +21,11 @@
 #include "config.h"
 #endif
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <glib/gstdio.h>
+
 #include <gst/check/gstcheck.h>
 
 static gboolean have_eos = FALSE;
@@ -303,6 +308,165 @@ GST_START_TEST (test_pull)
 
 GST_END_TEST;
 
+GST_START_TEST (test_pull_mmap)
+{
+  GstElement *src;
+  GstPad *pad;
+  GstFlowReturn ret;
+  GstBuffer *buffer1, *buffer2;
+  gchar *contents;
+  gsize length;
+  gboolean use_mmap;
+
+  fail_unless (g_file_get_contents (TESTFILE, &contents, &length, NULL));
+  fail_unless (length > 200);
+
+  src = setup_filesrc ();
+
+  g_object_set (G_OBJECT (src), "location", TESTFILE, "use-mmap", TRUE, NULL);
+  g_object_get (G_OBJECT (src), "use-mmap", &use_mmap, NULL);
+  fail_unless (use_mmap == TRUE);
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_READY) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to ready");
+
+  pad = gst_element_get_static_pad (src, "src");
+  fail_unless (pad != NULL);
+  fail_unless (gst_pad_activate_mode (pad, GST_PAD_MODE_PULL, TRUE));
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  buffer1 = NULL;
+  ret = gst_pad_get_range (pad, 0, 100, &buffer1);
+  fail_unless (ret == GST_FLOW_OK);
+  fail_unless (buffer1 != NULL);
+  fail_unless (gst_buffer_get_size (buffer1) == 100);
+  fail_unless (gst_buffer_memcmp (buffer1, 0, contents, 100) == 0);
+
+  buffer2 = NULL;
+  ret = gst_pad_get_range (pad, 150, 50, &buffer2);
+  fail_unless (ret == GST_FLOW_OK);
+  fail_unless (buffer2 != NULL);
+  fail_unless (gst_buffer_get_size (buffer2) == 50);
+  fail_unless (gst_buffer_memcmp (buffer2, 0, contents + 150, 50) == 0);
+
+#ifdef HAVE_SYS_MMAN_H
+  {
+    GstMapInfo map1, map2;
+
+    /* both buffers reference the same read-only mapping of the file */
+    fail_unless (gst_memory_is_readonly (gst_buffer_peek_memory (buffer1,
+                0)));
+    fail_unless (gst_memory_is_readonly (gst_buffer_peek_memory (buffer2,
+                0)));
+    fail_unless (gst_buffer_map (buffer1, &map1, GST_MAP_READ));
+    fail_unless (gst_buffer_map (buffer2, &map2, GST_MAP_READ));
+    fail_unless (map2.data == map1.data + 150);
+    gst_buffer_unmap (buffer2, &map2);
+    gst_buffer_unmap (buffer1, &map1);
+  }
+#endif
+  gst_buffer_unref (buffer2);
+
+  /* reading past the end is clipped as usual */
+  buffer2 = NULL;
+  ret = gst_pad_get_range (pad, length - 1, 10, &buffer2);
+  fail_unless (ret == GST_FLOW_OK);
+  fail_unless (buffer2 != NULL);
+  fail_unless (gst_buffer_get_size (buffer2) == 1);
+  fail_unless (gst_buffer_memcmp (buffer2, 0, contents + length - 1, 1) == 0);
+  gst_buffer_unref (buffer2);
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS, "could not set to null");
+
+  /* buffers stay valid after the file was closed */
+  fail_unless (gst_buffer_memcmp (buffer1, 0, contents, 100) == 0);
+  gst_buffer_unref (buffer1);
+
+  gst_object_unref (pad);
+  cleanup_filesrc (src);
+  g_free (contents);
+}
+
+GST_END_TEST;
+
+#if defined (HAVE_SYS_MMAN_H) && defined (HAVE_UNISTD_H)
+GST_START_TEST (test_pull_mmap_truncated)
+{
+  GstElement *src;
+  GstPad *pad;
+  GstFlowReturn ret;
+  GstBuffer *buffer;
+  gchar *filename;
+  guint8 *data;
+  gsize i;
+  gint fd;
+
+  data = g_malloc (65536);
+  for (i = 0; i < 65536; i++)
+    data[i] = i % 251;
+
+  fd = g_file_open_tmp ("filesrc-mmap-XXXXXX", &filename, NULL);
+  fail_unless (fd >= 0);
+  fail_unless (write (fd, data, 65536) == 65536);
+  close (fd);
+
+  src = setup_filesrc ();
+  g_object_set (G_OBJECT (src), "location", filename, "use-mmap", TRUE, NULL);
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_READY) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to ready");
+
+  pad = gst_element_get_static_pad (src, "src");
+  fail_unless (pad != NULL);
+  fail_unless (gst_pad_activate_mode (pad, GST_PAD_MODE_PULL, TRUE));
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  buffer = NULL;
+  ret = gst_pad_get_range (pad, 0, 4096, &buffer);
+  fail_unless (ret == GST_FLOW_OK);
+  fail_unless (gst_buffer_get_size (buffer) == 4096);
+  fail_unless (gst_memory_is_readonly (gst_buffer_peek_memory (buffer, 0)));
+  fail_unless (gst_buffer_memcmp (buffer, 0, data, 4096) == 0);
+  gst_buffer_unref (buffer);
+
+  /* the mapping must not be used anymore after the file was truncated,
+   * accessing it beyond the new end would raise SIGBUS */
+  fail_unless (truncate (filename, 1000) == 0);
+
+  buffer = NULL;
+  ret = gst_pad_get_range (pad, 0, 4096, &buffer);
+  fail_unless (ret == GST_FLOW_OK);
+  fail_unless (gst_buffer_get_size (buffer) == 1000);
+  fail_if (gst_memory_is_readonly (gst_buffer_peek_memory (buffer, 0)));
+  fail_unless (gst_buffer_memcmp (buffer, 0, data, 1000) == 0);
+  gst_buffer_unref (buffer);
+
+  buffer = NULL;
+  ret = gst_pad_get_range (pad, 8192, 100, &buffer);
+  fail_unless (ret == GST_FLOW_EOS);
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS, "could not set to null");
+
+  gst_object_unref (pad);
+  cleanup_filesrc (src);
+  g_unlink (filename);
+  g_free (filename);
+  g_free (data);
+}
+
+GST_END_TEST;
+#endif
+
 GST_START_TEST (test_coverage)
 {
   GstElement *src;
@@ -554,6 +718,10 @@ filesrc_suite (void)
   tcase_add_test (tc_chain, test_seeking);
   tcase_add_test (tc_chain, test_reverse);
   tcase_add_test (tc_chain, test_pull);
+  tcase_add_test (tc_chain, test_pull_mmap);
+#if defined (HAVE_SYS_MMAN_H) && defined (HAVE_UNISTD_H)
+  tcase_add_test (tc_chain, test_pull_mmap_truncated);
+#endif
   tcase_add_test (tc_chain, test_coverage);
   tcase_add_test (tc_chain, test_uri_interface);
   tcase_add_test (tc_chain, test_uri_query);
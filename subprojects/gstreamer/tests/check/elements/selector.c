@@ -629,6 +629,71 @@ GST_START_TEST (test_input_selector_switch_to_eos_stream)
 GST_END_TEST;
 
 
+static guint output_lists;
+
+static GstPadProbeReturn
+count_buffer_lists_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  output_lists++;
+
+  return GST_PAD_PROBE_OK;
+}
+
+/* @as_list: whether downstream is expected to receive the buffers as a single
+ * list instead of one by one */
+static void
+input_selector_push_buffer_list (gint stream, guint n_buffers,
+    enum InputSelectorResult res, gboolean as_list)
+{
+  GstBufferList *list;
+  GstPad *pad = stream == 1 ? stream1_pad : stream2_pad;
+  guint i;
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < n_buffers; i++)
+    gst_buffer_list_add (list, gst_buffer_new ());
+
+  fail_unless (buffers == NULL);
+  output_lists = 0;
+  fail_unless (gst_pad_push_list (pad, list) == GST_FLOW_OK);
+
+  if (res == INPUT_SELECTOR_DROP) {
+    fail_unless (buffers == NULL);
+    fail_unless_equals_int (output_lists, 0);
+  } else {
+    fail_unless_equals_int (g_list_length (buffers), n_buffers);
+    fail_unless_equals_int (output_lists, as_list ? 1 : 0);
+    g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+    buffers = NULL;
+  }
+}
+
+GST_START_TEST (test_input_selector_buffer_list)
+{
+  gulong probe;
+
+  setup_input_selector_with_2_streams (2);
+  probe = gst_pad_add_probe (output_pad, GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      count_buffer_lists_probe, NULL, NULL);
+
+  /* first list goes through the chain function to forward the sticky
+   * events, the next ones are forwarded as a whole */
+  input_selector_push_buffer_list (2, 3, INPUT_SELECTOR_FORWARD, FALSE);
+  input_selector_push_buffer_list (2, 5, INPUT_SELECTOR_FORWARD, TRUE);
+  input_selector_push_buffer_list (1, 4, INPUT_SELECTOR_DROP, FALSE);
+  input_selector_push_buffer (2, INPUT_SELECTOR_FORWARD);
+  input_selector_push_buffer_list (2, 2, INPUT_SELECTOR_FORWARD, TRUE);
+
+  input_selector_push_eos (2, TRUE);
+
+  gst_pad_remove_probe (output_pad, probe);
+  teardown_input_selector_with_2_streams ();
+}
+
+GST_END_TEST;
+
+
 GST_START_TEST (test_output_selector_no_srcpad_negotiation)
 {
   GstElement *sel;
@@ -840,6 +905,7 @@ selector_suite (void)
   tcase_add_test (tc_chain, test_input_selector_empty_stream);
   tcase_add_test (tc_chain, test_input_selector_shorter_stream);
   tcase_add_test (tc_chain, test_input_selector_switch_to_eos_stream);
+  tcase_add_test (tc_chain, test_input_selector_buffer_list);
   tcase_add_test (tc_chain, test_output_selector_no_srcpad_negotiation);
 
   tc_chain = tcase_create ("output-selector-negotiation");
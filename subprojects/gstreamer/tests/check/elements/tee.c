@@ -164,6 +164,309 @@ GST_START_TEST (test_stress)
 
 GST_END_TEST;
 
+/* fakesrc ! tee ! fakesink with async tee pads instead of queues. Each
+ * fakesink should exactly receive all buffers. */
+GST_START_TEST (test_async_pads)
+{
+#define NUM_ASYNC_SUBSTREAMS 4
+#define NUM_ASYNC_BUFFERS 50
+  GstElement *pipeline, *src, *tee;
+  GstElement *sinks[NUM_ASYNC_SUBSTREAMS];
+  GstPad *req_pads[NUM_ASYNC_SUBSTREAMS];
+  guint counts[NUM_ASYNC_SUBSTREAMS];
+  GstBus *bus;
+  GstMessage *msg;
+  guint64 dropped;
+  gint i;
+
+  pipeline = gst_pipeline_new ("pipeline");
+  src = gst_check_setup_element ("fakesrc");
+  g_object_set (src, "num-buffers", NUM_ASYNC_BUFFERS, NULL);
+  tee = gst_check_setup_element ("tee");
+  fail_unless (gst_bin_add (GST_BIN (pipeline), src));
+  fail_unless (gst_bin_add (GST_BIN (pipeline), tee));
+  fail_unless (gst_element_link (src, tee));
+
+  for (i = 0; i < NUM_ASYNC_SUBSTREAMS; ++i) {
+    GstPad *sinkpad;
+
+    counts[i] = 0;
+
+    sinks[i] = gst_check_setup_element ("fakesink");
+    fail_unless (gst_bin_add (GST_BIN (pipeline), sinks[i]));
+    g_object_set (sinks[i], "signal-handoffs", TRUE, NULL);
+    g_signal_connect (sinks[i], "handoff", (GCallback) handoff, &counts[i]);
+
+    /* no queues needed, tee pushes from a thread per branch */
+    req_pads[i] = gst_element_request_pad_simple (tee, "src_%u");
+    fail_unless (req_pads[i] != NULL);
+    g_object_set (req_pads[i], "async", TRUE, "max-size-buffers", 2, NULL);
+
+    sinkpad = gst_element_get_static_pad (sinks[i], "sink");
+    fail_unless_equals_int (gst_pad_link (req_pads[i], sinkpad),
+        GST_PAD_LINK_OK);
+    gst_object_unref (sinkpad);
+  }
+
+  bus = gst_element_get_bus (pipeline);
+  fail_if (bus == NULL);
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_if (GST_MESSAGE_TYPE (msg) != GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  /* not leaky, all buffers must have arrived in every branch */
+  for (i = 0; i < NUM_ASYNC_SUBSTREAMS; ++i) {
+    fail_unless_equals_int (counts[i], NUM_ASYNC_BUFFERS);
+    g_object_get (req_pads[i], "dropped", &dropped, NULL);
+    fail_unless_equals_uint64 (dropped, 0);
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (bus);
+
+  for (i = 0; i < NUM_ASYNC_SUBSTREAMS; ++i) {
+    gst_element_release_request_pad (tee, req_pads[i]);
+    gst_object_unref (req_pads[i]);
+  }
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+/* a downstream pad that can block in its chain function, used to fill up
+ * the queue of an async tee pad */
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  gboolean blocked;
+  guint n_entered;
+  guint n_buffers;
+} BlockingSink;
+
+static GstFlowReturn
+blocking_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  BlockingSink *sink = gst_pad_get_element_private (pad);
+
+  g_mutex_lock (&sink->lock);
+  sink->n_entered++;
+  g_cond_broadcast (&sink->cond);
+  while (sink->blocked)
+    g_cond_wait (&sink->cond, &sink->lock);
+  sink->n_buffers++;
+  g_cond_broadcast (&sink->cond);
+  g_mutex_unlock (&sink->lock);
+
+  gst_buffer_unref (buffer);
+
+  return GST_FLOW_OK;
+}
+
+static gboolean
+blocking_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  BlockingSink *sink = gst_pad_get_element_private (pad);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+    g_mutex_lock (&sink->lock);
+    sink->blocked = FALSE;
+    g_cond_broadcast (&sink->cond);
+    g_mutex_unlock (&sink->lock);
+  }
+  gst_event_unref (event);
+
+  return TRUE;
+}
+
+static void
+blocking_sink_wait_entered (BlockingSink * sink, guint n_entered)
+{
+  g_mutex_lock (&sink->lock);
+  while (sink->n_entered < n_entered)
+    g_cond_wait (&sink->cond, &sink->lock);
+  g_mutex_unlock (&sink->lock);
+}
+
+static void
+blocking_sink_wait_buffers (BlockingSink * sink, guint n_buffers)
+{
+  g_mutex_lock (&sink->lock);
+  while (sink->n_buffers < n_buffers)
+    g_cond_wait (&sink->cond, &sink->lock);
+  g_mutex_unlock (&sink->lock);
+}
+
+static void
+blocking_sink_set_blocked (BlockingSink * sink, gboolean blocked)
+{
+  g_mutex_lock (&sink->lock);
+  sink->blocked = blocked;
+  g_cond_broadcast (&sink->cond);
+  g_mutex_unlock (&sink->lock);
+}
+
+static GstStaticPadTemplate async_srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+static GstStaticPadTemplate async_sinktemplate =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+/* sets up a tee in PLAYING with one async source pad linked to @sink */
+static GstElement *
+setup_async_tee (BlockingSink * sink, GstPad ** srcpad, GstPad ** req_pad,
+    GstPad ** sinkpad)
+{
+  GstElement *tee;
+
+  g_mutex_init (&sink->lock);
+  g_cond_init (&sink->cond);
+  sink->blocked = FALSE;
+  sink->n_entered = 0;
+  sink->n_buffers = 0;
+
+  tee = gst_check_setup_element ("tee");
+  *srcpad = gst_check_setup_src_pad (tee, &async_srctemplate);
+
+  *req_pad = gst_element_request_pad_simple (tee, "src_%u");
+  fail_unless (*req_pad != NULL);
+  g_object_set (*req_pad, "async", TRUE, NULL);
+
+  *sinkpad = gst_pad_new_from_static_template (&async_sinktemplate, "sink");
+  gst_pad_set_element_private (*sinkpad, sink);
+  gst_pad_set_chain_function (*sinkpad, blocking_sink_chain);
+  gst_pad_set_event_function (*sinkpad, blocking_sink_event);
+  fail_unless_equals_int (gst_pad_link (*req_pad, *sinkpad), GST_PAD_LINK_OK);
+  gst_pad_set_active (*sinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (tee,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS);
+  gst_pad_set_active (*srcpad, TRUE);
+  gst_check_setup_events (*srcpad, tee, NULL, GST_FORMAT_BYTES);
+
+  return tee;
+}
+
+static void
+cleanup_async_tee (GstElement * tee, BlockingSink * sink, GstPad * req_pad,
+    GstPad * sinkpad)
+{
+  blocking_sink_set_blocked (sink, FALSE);
+  fail_unless (gst_element_set_state (tee,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS);
+  gst_pad_set_active (sinkpad, FALSE);
+  gst_object_unref (sinkpad);
+  gst_element_release_request_pad (tee, req_pad);
+  gst_object_unref (req_pad);
+  gst_check_teardown_src_pad (tee);
+  gst_check_teardown_element (tee);
+  g_mutex_clear (&sink->lock);
+  g_cond_clear (&sink->cond);
+}
+
+/* a leaky async pad drops the oldest queued buffers instead of blocking
+ * upstream when downstream is blocked */
+GST_START_TEST (test_async_leaky)
+{
+  BlockingSink sink;
+  GstElement *tee;
+  GstPad *srcpad, *req_pad, *sinkpad;
+  guint64 dropped;
+  gint i;
+
+  tee = setup_async_tee (&sink, &srcpad, &req_pad, &sinkpad);
+  g_object_set (req_pad, "leaky", TRUE, "max-size-buffers", 1, NULL);
+
+  /* the first buffer blocks the streaming thread downstream */
+  blocking_sink_set_blocked (&sink, TRUE);
+  fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_new ()),
+      GST_FLOW_OK);
+  blocking_sink_wait_entered (&sink, 1);
+
+  /* only the last one of these stays queued, none of them blocks */
+  for (i = 0; i < 9; i++)
+    fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_new ()),
+        GST_FLOW_OK);
+
+  g_object_get (req_pad, "dropped", &dropped, NULL);
+  fail_unless_equals_uint64 (dropped, 8);
+
+  blocking_sink_set_blocked (&sink, FALSE);
+  blocking_sink_wait_buffers (&sink, 2);
+
+  /* nothing else arrives */
+  g_usleep (G_USEC_PER_SEC / 20);
+  fail_unless_equals_int (sink.n_buffers, 2);
+  g_object_get (req_pad, "dropped", &dropped, NULL);
+  fail_unless_equals_uint64 (dropped, 8);
+
+  cleanup_async_tee (tee, &sink, req_pad, sinkpad);
+}
+
+GST_END_TEST;
+
+/* flushing an async pad with queued buffers discards them, and data flows
+ * again after the flush */
+GST_START_TEST (test_async_flush)
+{
+  BlockingSink sink;
+  GstElement *tee;
+  GstPad *srcpad, *req_pad, *sinkpad;
+  GstSegment segment;
+  guint n_buffers = 0;
+  gint i, j;
+
+  tee = setup_async_tee (&sink, &srcpad, &req_pad, &sinkpad);
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+
+  for (i = 0; i < 100; i++) {
+    blocking_sink_set_blocked (&sink, TRUE);
+    fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_new ()),
+        GST_FLOW_OK);
+    blocking_sink_wait_entered (&sink, n_buffers + 1);
+
+    for (j = 0; j < 3; j++)
+      fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_new ()),
+          GST_FLOW_OK);
+
+    /* on odd iterations let the queue drain first so that the streaming
+     * thread might be paused between two iterations */
+    if (i % 2) {
+      blocking_sink_set_blocked (&sink, FALSE);
+      blocking_sink_wait_buffers (&sink, n_buffers + 4);
+      n_buffers += 4;
+    } else {
+      /* the flush unblocks downstream, the queued buffers are dropped */
+      n_buffers += 1;
+    }
+
+    fail_unless (gst_pad_push_event (srcpad, gst_event_new_flush_start ()));
+    fail_unless (gst_pad_push_event (srcpad, gst_event_new_flush_stop (TRUE)));
+    fail_unless (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+
+    /* the streaming thread has to be restarted */
+    fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_new ()),
+        GST_FLOW_OK);
+    blocking_sink_wait_buffers (&sink, n_buffers + 1);
+    n_buffers += 1;
+
+    g_mutex_lock (&sink.lock);
+    fail_unless_equals_int (sink.n_buffers, n_buffers);
+    g_mutex_unlock (&sink.lock);
+  }
+
+  cleanup_async_tee (tee, &sink, req_pad, sinkpad);
+}
+
+GST_END_TEST;
+
 typedef struct
 {
   GstElement *tee;
@@ -953,6 +1256,9 @@ tee_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_num_buffers);
   tcase_add_test (tc_chain, test_stress);
+  tcase_add_test (tc_chain, test_async_pads);
+  tcase_add_test (tc_chain, test_async_leaky);
+  tcase_add_test (tc_chain, test_async_flush);
   tcase_add_test (tc_chain, test_release_while_buffer_alloc);
   tcase_add_test (tc_chain, test_release_while_second_buffer_alloc);
   tcase_add_test (tc_chain, test_internal_links);
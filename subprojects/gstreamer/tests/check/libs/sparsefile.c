@@ -211,6 +211,56 @@ GST_START_TEST (test_write_merge)
 
 GST_END_TEST;
 
+GST_START_TEST (test_write_fill_gaps)
+{
+  GstSparseFile *file;
+  gint fd;
+  gchar *name;
+
+  name = g_strdup ("cachefile-testXXXXXX");
+  fd = g_mkstemp (name);
+  fail_if (fd == -1);
+
+  file = gst_sparse_file_new ();
+  gst_sparse_file_set_fd (file, fd);
+
+  /* three disjoint ranges, the last one is the current write range */
+  fail_unless (expect_write (file, 0, 100, 100, 0));
+  fail_unless (expect_write (file, 200, 100, 100, 0));
+  fail_unless (expect_write (file, 400, 100, 100, 0));
+  fail_unless (gst_sparse_file_n_ranges (file) == 3);
+
+  /* fill the first gap, this merges the first two ranges */
+  fail_unless (expect_write (file, 100, 100, 100, 100));
+  fail_unless (gst_sparse_file_n_ranges (file) == 2);
+  expect_range_before (file, 150, 0, 300);
+  expect_range_before (file, 450, 400, 500);
+
+  /* extend the last range */
+  fail_unless (expect_write (file, 500, 100, 100, 0));
+  fail_unless (gst_sparse_file_n_ranges (file) == 2);
+  expect_range_before (file, 150, 0, 300);
+  expect_range_before (file, 450, 400, 600);
+
+  /* fill the second gap, everything is one range now */
+  fail_unless (expect_write (file, 300, 100, 100, 200));
+  fail_unless (gst_sparse_file_n_ranges (file) == 1);
+  expect_range_before (file, 550, 0, 600);
+
+  /* and keep writing at the end */
+  fail_unless (expect_write (file, 600, 100, 100, 0));
+  fail_unless (gst_sparse_file_n_ranges (file) == 1);
+  expect_range_before (file, 650, 0, 700);
+
+  fail_unless (expect_read (file, 250, 200, 200, 250));
+
+  g_unlink (name);
+  gst_sparse_file_free (file);
+  g_free (name);
+}
+
+GST_END_TEST;
+
 static Suite *
 gst_cachefile_suite (void)
 {
@@ -220,6 +270,7 @@ gst_cachefile_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_write_read);
   tcase_add_test (tc_chain, test_write_merge);
+  tcase_add_test (tc_chain, test_write_fill_gaps);
 
   return s;
 }
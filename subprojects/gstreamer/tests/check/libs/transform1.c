@@ -887,6 +887,86 @@ GST_START_TEST (basetransform_chain_ct3)
 
 GST_END_TEST;
 
+static gint allocation_queries;
+
+static gboolean
+result_sink_query_count (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION)
+    allocation_queries++;
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/* copy-transform that starts in passthrough mode and leaves it after
+ * negotiation, the allocation query should be done when the first output
+ * buffer is needed and only once */
+GST_START_TEST (basetransform_chain_ct_delayed_pool)
+{
+  TestTransData *trans;
+  GstBuffer *buffer;
+  GstFlowReturn res;
+  GstCaps *caps;
+
+  klass_transform = transform_ct1;
+
+  trans = gst_test_trans_new ();
+  gst_pad_set_query_function (trans->sinkpad, result_sink_query_count);
+  gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (trans->trans), TRUE);
+
+  allocation_queries = 0;
+  caps = gst_caps_new_empty_simple ("foo/x-bar");
+  gst_test_trans_setcaps (trans, caps);
+  gst_test_trans_push_segment (trans);
+  fail_unless_equals_int (allocation_queries, 0);
+
+  /* passthrough, no allocation needed */
+  buffer = gst_buffer_new_and_alloc (20);
+  transform_ct1_called = FALSE;
+  res = gst_test_trans_push (trans, buffer);
+  fail_unless (res == GST_FLOW_OK);
+  fail_unless (transform_ct1_called == FALSE);
+  fail_unless_equals_int (allocation_queries, 0);
+
+  buffer = gst_test_trans_pop (trans);
+  fail_unless (buffer != NULL);
+  gst_buffer_unref (buffer);
+
+  /* leave passthrough without renegotiating */
+  gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (trans->trans),
+      FALSE);
+
+  buffer = gst_buffer_new_and_alloc (20);
+  transform_ct1_called = FALSE;
+  transform_ct1_writable = FALSE;
+  res = gst_test_trans_push (trans, buffer);
+  fail_unless (res == GST_FLOW_OK);
+  fail_unless (transform_ct1_called == TRUE);
+  fail_unless (transform_ct1_writable == TRUE);
+  fail_unless_equals_int (allocation_queries, 1);
+
+  buffer = gst_test_trans_pop (trans);
+  fail_unless (buffer != NULL);
+  fail_unless (gst_buffer_get_size (buffer) == 20);
+  gst_buffer_unref (buffer);
+
+  /* the next buffer reuses the decided allocation */
+  buffer = gst_buffer_new_and_alloc (20);
+  res = gst_test_trans_push (trans, buffer);
+  fail_unless (res == GST_FLOW_OK);
+  fail_unless_equals_int (allocation_queries, 1);
+
+  buffer = gst_test_trans_pop (trans);
+  fail_unless (buffer != NULL);
+  gst_buffer_unref (buffer);
+
+  gst_caps_unref (caps);
+
+  gst_test_trans_free (trans);
+}
+
+GST_END_TEST;
+
 static gboolean transform_fixate_caps_invalid_called = FALSE;
 
 static GstCaps *
@@ -981,6 +1061,7 @@ gst_basetransform_suite (void)
   tcase_add_test (tc, basetransform_chain_ct1);
   tcase_add_test (tc, basetransform_chain_ct2);
   tcase_add_test (tc, basetransform_chain_ct3);
+  tcase_add_test (tc, basetransform_chain_ct_delayed_pool);
 
   tcase_add_test (tc, basetransform_invalid_fixatecaps_impl);
 
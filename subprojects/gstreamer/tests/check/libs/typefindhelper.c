@@ -34,11 +34,18 @@ static const guint8 vorbisid[30] = { 0x01, 0x76, 0x6f, 0x72, 0x62, 0x69, 0x73,
 };
 
 static void foobar_typefind (GstTypeFind * tf, gpointer unused);
+static void early_typefind (GstTypeFind * tf, gpointer unused);
+static void late_typefind (GstTypeFind * tf, gpointer unused);
+
+static gboolean late_typefind_called;
 
 static GstStaticCaps foobar_caps = GST_STATIC_CAPS ("foo/x-bar");
 
 #define FOOBAR_CAPS (gst_static_caps_get (&foobar_caps))
 
+static GstStaticCaps early_caps = GST_STATIC_CAPS ("early/x-ext");
+static GstStaticCaps late_caps = GST_STATIC_CAPS ("late/x-ext");
+
 /* make sure the entire data in the buffer is available for peeking */
 GST_START_TEST (test_buffer_range)
 {
@@ -72,6 +79,39 @@ GST_START_TEST (test_buffer_range)
 
 GST_END_TEST;
 
+/* typefinders for the extension run first and a maximum probability result
+ * stops typefinding */
+GST_START_TEST (test_extension_early_exit)
+{
+  GstTypeFindProbability prob;
+  GstCaps *caps;
+
+  fail_unless (gst_type_find_register (NULL, "early/x-ext",
+          GST_RANK_MARGINAL, early_typefind, "early",
+          gst_static_caps_get (&early_caps), NULL, NULL));
+  fail_unless (gst_type_find_register (NULL, "late/x-ext",
+          GST_RANK_PRIMARY + 100, late_typefind, "late",
+          gst_static_caps_get (&late_caps), NULL, NULL));
+
+  late_typefind_called = FALSE;
+  caps = gst_type_find_helper_for_data_with_extension (NULL, vorbisid,
+      sizeof (vorbisid), "early", &prob);
+  fail_unless (caps != NULL);
+  fail_unless (gst_structure_has_name (gst_caps_get_structure (caps, 0),
+          "early/x-ext"));
+  fail_unless_equals_int (prob, GST_TYPE_FIND_MAXIMUM);
+  fail_if (late_typefind_called);
+  gst_caps_unref (caps);
+
+  /* without the extension the higher ranked typefinder runs first */
+  caps = gst_type_find_helper_for_data (NULL, vorbisid, sizeof (vorbisid),
+      NULL);
+  fail_unless (late_typefind_called);
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
 static Suite *
 gst_typefindhelper_suite (void)
 {
@@ -80,6 +120,7 @@ gst_typefindhelper_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_buffer_range);
+  tcase_add_test (tc_chain, test_extension_early_exit);
 
   return s;
 }
@@ -121,3 +162,20 @@ foobar_typefind (GstTypeFind * tf, gpointer unused)
 
   gst_type_find_suggest (tf, GST_TYPE_FIND_MAXIMUM, FOOBAR_CAPS);
 }
+
+static void
+early_typefind (GstTypeFind * tf, gpointer unused)
+{
+  fail_unless (gst_type_find_peek (tf, 0, 10) != NULL);
+  gst_type_find_suggest (tf, GST_TYPE_FIND_MAXIMUM,
+      gst_static_caps_get (&early_caps));
+
+  /* no more data once the type is certain */
+  fail_unless (gst_type_find_peek (tf, 0, 10) == NULL);
+}
+
+static void
+late_typefind (GstTypeFind * tf, gpointer unused)
+{
+  late_typefind_called = TRUE;
+}